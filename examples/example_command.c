@@ -6,7 +6,7 @@ int main(/* ... */)
     // The first is initializing the command itself
     command_s main_command = {0}; // usually it's a good idea to zero-init them on the stack.
     command_init(&main_command, // The first parameter is a pointer to the command
-                 1              // The second is the amount of options that will be part of this command
+                 1              // The second is the initial capacity for options, the command grows when more are added (0 is allowed)
                  );
     // When we're done initializing the base of the command, we give it a name:
     command_set_name(&main_command,    // Again, the first param is a pointer to the command
@@ -26,7 +26,8 @@ int main(/* ... */)
     command_add_option(&main_command,  // Command pointer
                        &boolean_option // pointer to the option
                        );
-    // This add function returns true or false, depending on if there's enough space available for the option to be added.
+    // This add function returns true or false, depending on if the option could be added.
+    // Adding fails once the command is frozen, or when growing the option storage fails.
 
     // ---------------------------- //
     // Parsing the command_tree ... //
@@ -12,6 +12,7 @@ void print_global_help(FILE* stream, const command_tree_s* command_tree);
 void print_command_inline_help(FILE* stream, const command_s* command);
 void print_command_help(FILE* stream, const command_s* command);
 void print_option_inline_help(FILE* stream, const option_s* option);
+void print_positional_inline_help(FILE* stream, const positional_s* positional);
 
 #endif // !COMMAND_PARSER__BUILTIN__HELP_H__
 
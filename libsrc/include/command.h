@@ -3,12 +3,22 @@
 
 #include "command_types.h"
 
+#define COMMAND_END_OF_OPTIONS "--"
+
 bool command_init(command_s* command, size_t option_capacity);
+bool command_init_borrowed(command_s* command, size_t option_capacity);
 bool command_set_name(command_s* command, const char* name, size_t alias_n, ...);
 bool command_set_description(command_s* command, const char* description);
+bool command_set_handler(command_s* command, command_handler_f handler, void* context);
 void command_clean(command_s* command);
 
 bool command_add_option(command_s* command, option_s* option);
+bool command_add_exclusive_group(command_s* command, size_t flag_n, ...);
+bool command_add_requirement(command_s* command, const char* option_flag, size_t required_n, ...);
+bool command_add_at_least_one_group(command_s* command, size_t flag_n, ...);
+bool command_add_positional(command_s* command, const char* name, option_type_e type, size_t min_count, size_t max_count);
+bool command_freeze(command_s* command);
+bool command_index_global_options(command_s* command, const command_s* globals);
 
 bool command_parse(command_s* command);
 bool command_is_option_present(const command_s* command, const char* option_flag);
@@ -16,12 +26,19 @@ bool command_has_missing_required_options(const command_s* command);
 option_s* command_get_missing_required_options(const command_s* command, int* missing_count);
 size_t command_get_missing_required_options_static(const command_s* command, option_s* missing_buffer, size_t buffer_length);
 option_s* command_find_option(const command_s* command, const char* option_flag);
+size_t command_get_missing_required_option_indices(const command_s* command, size_t* index_buffer, size_t buffer_length);
+const option_s* command_get_option(const command_s* command, size_t option_index);
+bool command_is_option_defaulted(const command_s* command, const char* option_flag);
+bool command_set_option_value(command_s* command, const char* option_flag, const void* value);
 
 bool command_is_of_flag(const command_s* command, const char* command_name);
 const char* command_get_name(const command_s* command);
 const char* command_get_description(const command_s* command);
 const char* command_get_passed_name(const command_s* command);
 const char** command_get_parameters(const command_s* command, int* parameter_count);
+const char* const* command_get_passthrough(const command_s* command, size_t* passthrough_count);
+const diagnostics_s* command_get_diagnostics(const command_s* command);
+const positional_s* command_find_positional(const command_s* command, const char* name);
 
 const void* command_read_option(const command_s* command, const char* option_flag);
 bool command_read_bool_option(const command_s* command, const char* option_flag);
@@ -29,6 +46,20 @@ int command_read_int_option(const command_s* command, const char* option_flag);
 float command_read_float_option(const command_s* command, const char* option_flag);
 const char* command_read_string_option(const command_s* command, const char* option_flag);
 const char** command_read_multi_string_option(const command_s* command, const char* option_flag, size_t* string_count);
+const char** command_read_string_list_option(const command_s* command, const char* option_flag, size_t* string_count);
+size_t command_read_count_option(const command_s* command, const char* option_flag);
+int command_read_choice_option(const command_s* command, const char* option_flag);
+const char* command_read_choice_name_option(const command_s* command, const char* option_flag);
+uint64_t command_read_size_option(const command_s* command, const char* option_flag);
+uint64_t command_read_duration_option(const command_s* command, const char* option_flag);
+const void* command_read_custom_option(const command_s* command, const char* option_flag, const option_type_vtable_s* custom_type);
+
+size_t command_get_positional_count(const command_s* command, const char* name);
+int command_read_int_positional(const command_s* command, const char* name, size_t index);
+float command_read_float_positional(const command_s* command, const char* name, size_t index);
+const char* command_read_string_positional(const command_s* command, const char* name, size_t index);
+uint64_t command_read_size_positional(const command_s* command, const char* name, size_t index);
+uint64_t command_read_duration_positional(const command_s* command, const char* name, size_t index);
 
 #endif // !COMMAND_PARSER__COMMAND_H__
 
@@ -0,0 +1,41 @@
+#ifndef COMMAND_PARSER__COMMAND_ARGV_H__
+#define COMMAND_PARSER__COMMAND_ARGV_H__
+
+/** \file command_argv.h
+ * This is the header file containg the function to rebuild an argv array from a parsed `command_s`,
+ * for example to `execve()` a child process with a few of the options changed through `command_set_option_value()`.
+ *
+ * The array and everything it points to that isn't referenced live in a single buffer supplied by the caller:
+ *  - The `char*` array itself, terminated by a `NULL` pointer like the argv of `main()`.
+ *  - The text of the values that were overridden after parsing, formatted from their typed value.
+ *
+ * All the other strings are referenced, not copied: the program name, the names of the command and options,
+ * the values that were read from the parsed argv as-is, the positional parameters and the passthrough slice.
+ * The rebuilt array is only valid as long as the command-tree and the argv it parsed.
+ *
+ * The command is followed by its positional parameters, so a multi-string option can't swallow them,
+ * then by the present options of the command and the global options, and lastly by `--` and the passthrough slice
+ * when the end-of-options marker was passed.
+ */
+
+#include "command_types.h"
+
+/**
+ * @brief Rebuilds the argv **command** was parsed from into **buffer**.
+ *
+ * Works like `snprintf()`: the size required for the complete array is always returned,
+ * but the array is only written when **buffer_length** is large enough to hold it.
+ * Call it with a `NULL` **buffer** and _0_ as **buffer_length** to query the required size.
+ *
+ * @param command The command to rebuild, after calling `command_parse()`.
+ * @param program The first element of the array, or `NULL` to start the array with the command.
+ * @param names Whether the command and options are written with their main names or the names they were called with.
+ * @param buffer The buffer the array is written into, aligned for a `char*`. Cast it to `char**` to use the array.
+ * @param buffer_length The size of **buffer** in bytes.
+ * @param argc Set to the amount of elements in the array, not counting the terminating `NULL`, when not `NULL`.
+ *
+ * @return The size of the complete array in bytes, or _0_ when **command** is `NULL` or **names** is out of range.
+ */
+size_t command_write_argv(const command_s* command, const char* program, argv_names_e names, void* buffer, size_t buffer_length, size_t* argc);
+
+#endif // !COMMAND_PARSER__COMMAND_ARGV_H__
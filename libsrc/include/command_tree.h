@@ -3,16 +3,24 @@
 
 #include "command_types.h"
 
+#define COMMAND_TREE_RUN_FAILURE (-1)
+
 bool command_tree_init(command_tree_s* tree, size_t command_capacity);
+bool command_tree_init_borrowed(command_tree_s* tree, size_t command_capacity);
 bool command_tree_set_description(command_tree_s* tree, const char* description);
 void command_tree_clean(command_tree_s* tree);
 
 bool command_tree_add_command(command_tree_s* tree, command_s* command);
+bool command_tree_add_global_option(command_tree_s* tree, option_s* option);
+bool command_tree_freeze(command_tree_s* tree);
 const command_s* command_tree_get_command(const command_tree_s* tree, const char* command_flag);
 bool command_tree_has_command(const command_tree_s* tree, const char* command_flag);
 
 bool command_tree_parse_base(command_tree_s* tree, int argc, const char** argv);
+bool command_tree_parse_line(command_tree_s* tree, char* line, size_t length);
 command_s* command_tree_get_called_command(command_tree_s* tree);
+int command_tree_run(command_tree_s* tree, int argc, const char** argv);
+const diagnostics_s* command_tree_get_diagnostics(const command_tree_s* tree);
 
 #endif // !COMMAND_PARSER__COMMAND_TREE_H__
 
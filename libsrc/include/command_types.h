@@ -5,11 +5,28 @@
  * This header file contains all the defenitions of the immediate values
  * used within the command-tree structure important to the user:
  *  - Enum: `option_type_e`; the different types of options
+ *  - Enum: `option_repeat_policy_e`; how an option behaves when it's passed more than once
+ *  - Enum: `diagnostic_code_e`; the kinds of problems found while registering or parsing
+ *  - Enum: `parse_stats_phase_e`; the phases timed by the optional statistics
+ *  - Enum: `parse_stats_counter_e`; the events counted by the optional statistics
+ *  - Enum: `memory_usage_category_e`; the kinds of memory reported by the memory usage
+ *  - Enum: `argv_names_e`; which names of the options are used when rebuilding argv
+ *  - Enum: `constraint_kind_e`; the relationships that can be declared between the options of a command
+ *  - Enum: `parse_event_kind_e`; the kinds of events yielded by a `parse_iter_s`
+ *  - Struct: `diagnostics_s`; the buffer collecting `diagnostic_s` entries for the caller to inspect.
+ *  - Struct: `parse_stats_s`; the timings and counters collected per command-tree when built with `COMMAND_PARSER_ENABLE_STATS`.
+ *  - Struct: `memory_usage_s`; the bytes held by a command-tree or command, per category.
  *  - Struct: `arguments_s`; the structure containg argument information for commands/options.
  *  - Struct: `notation_s`; the structure containing the info on how a command/option should be addressed.
+ *  - Struct: `option_choices_s`; the allowed values of an `OPTION_TYPE_CHOICE` option and their lookup-table.
+ *  - Struct: `option_type_vtable_s`; the conversion functions of a user-defined `OPTION_TYPE_CUSTOM` option.
  *  - Struct: `option_s`; the option can be an extra flag containing data registered to a command
+ *  - Struct: `positional_s`; a typed slot of a command, filled by its positional parameters while parsing.
+ *  - Struct: `constraint_s`; a relationship between options of a command, checked against the passed options after parsing.
  *  - Struct: `command_s`; the command is the first called flag in argv and should indicate the main logic of what the caller wants to do, it is registered to a `command_tree_s`.
  *  - Struct: `command_tree_s`: the root of the tree-like structure, this is where commands are registered to.
+ *  - Struct: `parse_event_s`; a single option, value, parameter or unknown flag yielded by a `parse_iter_s`.
+ *  - Struct: `parse_iter_s`; the state of a parse that yields its events one at a time instead of storing them.
  */
 
 #include "extra/shared_value.h"
@@ -27,9 +44,177 @@ typedef enum option_type_
     OPTION_TYPE_FLOAT,        /**< This is the float-type-flag. Example usage: `--my-float-flag 2.3` */
     OPTION_TYPE_STRING,       /**< This is the string-type flag. Example usage: `--my-string-flag word`*/
     OPTION_TYPE_MULTI_STRING, /**< This is the mult-string-type flag. This flag is special in the sence that it greedy-reads all the following values until the end or when another flag is found. Example usage: `--my-m-string-flag all these disconnected words are read` */
+    OPTION_TYPE_CHOICE,       /**< This is the choice-type flag. The value has to be one of the choices registered with `option_set_choices()`, and is read as the index of that choice. Example usage: `--mode safe` */
+    OPTION_TYPE_SIZE,         /**< This is the size-type flag. The value is an amount of bytes with an optional SI or IEC suffix, read as a `uint64_t`. Example usage: `--cache 512MiB` */
+    OPTION_TYPE_DURATION,     /**< This is the duration-type flag. The value is one or more numbers with a unit from `ns` up to `h`, read as a `uint64_t` of nanoseconds. Example usage: `--timeout 1h30m` */
+    OPTION_TYPE_CUSTOM,       /**< This is the user-defined-type flag. The value is converted by the `option_type_vtable_s` passed to `option_init_custom()`. Example usage: `--address 10.0.0.1` */
     MAX_OPTION_TYPE_COUNT
 } option_type_e;
 
+/**
+ * This enum is used by `option_s` to denote what happens when the option is passed more than once.
+ */
+typedef enum option_repeat_policy_
+{
+    OPTION_REPEAT_FIRST_WINS, /**< The default. Every occurrence after the first one is ignored, along with its value. */
+    OPTION_REPEAT_LAST_WINS,  /**< Every occurrence overrides the value of the previous one. Example usage: `--level 1 --level 3` reads `3` */
+    OPTION_REPEAT_COUNT,      /**< Only for `OPTION_TYPE_BOOL`. The occurrences are counted. Example usage: `-v -v -v` counts `3` */
+    OPTION_REPEAT_ACCUMULATE, /**< Only for `OPTION_TYPE_STRING` and `OPTION_TYPE_MULTI_STRING`. The values of every occurrence are gathered into one list. Example usage: `--include a --include b` */
+    MAX_OPTION_REPEAT_POLICY_COUNT
+} option_repeat_policy_e;
+
+
+/**
+ * This enum is used by `diagnostic_s` to denote what kind of problem was found.
+ */
+typedef enum diagnostic_code_
+{
+    DIAGNOSTIC_UNKNOWN_OPTION,   /**< A flag was passed that isn't an option of the command. The flag is kept as a parameter. */
+    DIAGNOSTIC_REPEATED_OPTION,  /**< A warning. An option with `OPTION_REPEAT_FIRST_WINS` was passed more than once, the later occurrence and its value were ignored. */
+    DIAGNOSTIC_INVALID_VALUE,    /**< An option was passed without a valid value for its type. */
+    DIAGNOSTIC_UNKNOWN_COMMAND,  /**< The first argument isn't a command of the command-tree. */
+    DIAGNOSTIC_MISSING_COMMAND,  /**< No command was passed at all. */
+    DIAGNOSTIC_MISSING_HANDLER,  /**< The called command has no handler to dispatch to. */
+    DIAGNOSTIC_MISSING_NAME,     /**< A command or option was registered without a name. */
+    DIAGNOSTIC_INVALID_ALIAS,    /**< A command or option holds an alias that was discarded for not being a valid flag. */
+    DIAGNOSTIC_DUPLICATE_FLAG,   /**< A name or alias is used more than once within the same command or command-tree. */
+    DIAGNOSTIC_OUT_OF_MEMORY,    /**< An allocation failed while parsing or freezing. */
+    DIAGNOSTIC_INVALID_LINE,     /**< A line passed to `command_tree_parse_line()` holds a quote that isn't closed or ends in a lone backslash. */
+    DIAGNOSTIC_MISSING_POSITIONAL, /**< Fewer parameters were passed than the positionals of the command require. `flag` is the name of the first positional that's short. */
+    DIAGNOSTIC_EXTRA_POSITIONAL,   /**< More parameters were passed than the positionals of the command take. `flag` is the first parameter left over. */
+    DIAGNOSTIC_EXCLUSIVE_OPTIONS,  /**< More than one option of a `CONSTRAINT_EXCLUSIVE` group was passed. `related_flags` are the ones that were passed. */
+    DIAGNOSTIC_MISSING_DEPENDENCY, /**< The option `flag` was passed without the options it requires. `related_flags` are the ones that are missing. */
+    DIAGNOSTIC_MISSING_ONE_OF,     /**< None of the options of a `CONSTRAINT_AT_LEAST_ONE` group was passed. `related_flags` are the options of the group. */
+    MAX_DIAGNOSTIC_CODE_COUNT
+} diagnostic_code_e;
+
+/**
+ * A single problem found while registering or parsing.
+ *
+ * `argv_index` is relative to the `arguments_s::argv_arguments` of the structure that reported it,
+ * or `DIAGNOSTIC_NO_ARGV_INDEX` when the problem wasn't caused by an argument.
+ * `flag` is not owned by the diagnostic, it points into argv or into the `notation_s` that caused it.
+ */
+typedef struct diagnostic_
+{
+    diagnostic_code_e code;
+    size_t argv_index;
+    const char* flag;
+    option_type_e expected_type; /**< the type of the option involved, `MAX_OPTION_TYPE_COUNT` when there's none. */
+    const struct option_choices_* choices; /**< the choices the value should have been one of, for an `OPTION_TYPE_CHOICE` option. */
+    const struct option_type_vtable_* custom_type; /**< the type the value should have been, for an `OPTION_TYPE_CUSTOM` option. */
+    const char* const* related_flags; /**< the other flags involved in a violated constraint, owned by the `constraint_s` and valid until the next parse. */
+    size_t related_flag_count;
+} diagnostic_s;
+
+#define DIAGNOSTIC_NO_ARGV_INDEX ((size_t)-1)
+
+#define NOTATION_SHORT_NAME_SIZE  16 /**< the size of an inline name of a `notation_s`, including its NUL-terminator. */
+#define NOTATION_SHORT_NAME_COUNT 4  /**< the amount of inline names of a `notation_s`, the main name and up to three aliases. */
+
+/**
+ * This structure collects diagnostics instead of printing them, so the caller can inspect, format or drop them.
+ * The `entries` array is heap-allocated and grows geometrically, clearing it keeps the allocation around for reuse.
+ *
+ * For functionality and usage of this structure, look into the `diagnostics.h` header-file.
+ */
+typedef struct diagnostics_
+{
+    size_t count;
+    size_t capacity;
+    diagnostic_s* entries;
+} diagnostics_s;
+
+/**
+ * This enum is used by `parse_stats_s` to denote which phase of the command-tree a timing belongs to.
+ * Phases can nest: the time of `PARSE_STATS_PHASE_CONVERSION` is also part of `PARSE_STATS_PHASE_COMMAND_PARSE`.
+ */
+typedef enum parse_stats_phase_
+{
+    PARSE_STATS_PHASE_CONSTRUCTION,  /**< Initializing, adding commands to, freezing and loading the command-tree. */
+    PARSE_STATS_PHASE_PARSE_BASE,    /**< `command_tree_parse_base()`. */
+    PARSE_STATS_PHASE_COMMAND_PARSE, /**< `command_parse()` of a command registered to the command-tree. */
+    PARSE_STATS_PHASE_CONVERSION,    /**< Converting the arguments of an option into its typed value. */
+    PARSE_STATS_PHASE_CLEAN,         /**< `command_tree_clean()`. */
+    MAX_PARSE_STATS_PHASE_COUNT
+} parse_stats_phase_e;
+
+/**
+ * This enum is used by `parse_stats_s` to denote what kind of event was counted.
+ */
+typedef enum parse_stats_counter_
+{
+    PARSE_STATS_ARGS_SCANNED,    /**< Arguments of argv looked at while parsing. */
+    PARSE_STATS_FLAG_LOOKUPS,    /**< Searches for a command or option by its flag. */
+    PARSE_STATS_STRING_COMPARES, /**< Flags compared against a name or alias. */
+    PARSE_STATS_ALLOCATIONS,     /**< Allocations and reallocations made by the library. */
+    PARSE_STATS_ALLOCATED_BYTES, /**< The amount of bytes requested by those allocations. */
+    MAX_PARSE_STATS_COUNTER_COUNT
+} parse_stats_counter_e;
+
+/**
+ * This structure holds the statistics of a single command-tree.
+ * It is only filled in when the library is built with `COMMAND_PARSER_ENABLE_STATS`, otherwise it stays zeroed.
+ *
+ * For functionality and usage of this structure, look into the `parse_stats.h` header-file.
+ */
+typedef struct parse_stats_
+{
+    uint64_t phase_nanoseconds[MAX_PARSE_STATS_PHASE_COUNT]; /**< the total time spent in each phase. */
+    uint64_t phase_calls[MAX_PARSE_STATS_PHASE_COUNT];       /**< the amount of times each phase was entered. */
+    uint64_t counters[MAX_PARSE_STATS_COUNTER_COUNT];
+} parse_stats_s;
+
+/**
+ * This enum is used by `memory_usage_s` to denote what the counted bytes are held for.
+ */
+typedef enum memory_usage_category_
+{
+    MEMORY_USAGE_STRUCTURES,    /**< The arrays of commands and options with their bitsets, or the single block holding them once frozen. */
+    MEMORY_USAGE_NAMES,         /**< The main names of commands and options. */
+    MEMORY_USAGE_ALIASES,       /**< The alias arrays and the aliases themselves. */
+    MEMORY_USAGE_DESCRIPTIONS,  /**< The descriptions of the command-tree, commands and options. */
+    MEMORY_USAGE_STRING_POOL,   /**< The pool the names, aliases and descriptions are interned into when freezing. */
+    MEMORY_USAGE_SHARED_VALUES, /**< The use count and `notation_s` of every `shared_value_s` of an option. */
+    MEMORY_USAGE_DEFAULTS,      /**< The default values of options and the choices of `OPTION_TYPE_CHOICE` options. */
+    MEMORY_USAGE_INDICES,       /**< The flag lookup-indices. */
+    MEMORY_USAGE_VALUES,        /**< The `set_value` of every passed option. */
+    MEMORY_USAGE_PARAMETERS,    /**< The `parameters` arrays of the last parse and the tokens of `command_tree_parse_line()`. */
+    MEMORY_USAGE_DIAGNOSTICS,   /**< The buffers of the diagnostics. */
+    MAX_MEMORY_USAGE_CATEGORY_COUNT
+} memory_usage_category_e;
+
+/**
+ * This structure holds the amount of heap-allocated bytes held by a command-tree or a command, as requested from the allocator.
+ *
+ * For functionality and usage of this structure, look into the `memory_usage.h` header-file.
+ */
+typedef struct memory_usage_
+{
+    size_t bytes[MAX_MEMORY_USAGE_CATEGORY_COUNT];
+    size_t total; /**< the sum of all the categories. */
+} memory_usage_s;
+
+/**
+ * This enum is used by `command_write_argv()` to denote how the command and its options are named in the rebuilt argv.
+ */
+typedef enum argv_names_
+{
+    ARGV_NAMES_CANONICAL, /**< The main name of the command and of every option. */
+    ARGV_NAMES_AS_PASSED, /**< The name or alias the command and options were called with, falling back to the main name for options set after parsing. */
+    MAX_ARGV_NAMES_COUNT
+} argv_names_e;
+
+/**
+ * This enum is used by `constraint_s` to denote how its options relate to each other.
+ */
+typedef enum constraint_kind_
+{
+    CONSTRAINT_EXCLUSIVE,    /**< At most one of the options can be passed. Example usage: `--json` and `--yaml` */
+    CONSTRAINT_REQUIRES,     /**< When the first option is passed, all the other options have to be passed as well. */
+    CONSTRAINT_AT_LEAST_ONE, /**< At least one of the options has to be passed. */
+    MAX_CONSTRAINT_KIND_COUNT
+} constraint_kind_e;
 
 /**
  * This structure holds all the litteral passed values from argv+argc.
@@ -58,6 +243,17 @@ typedef struct arguments_
  *
  * All the strings are heap-allocted and free'd again when cleaning up the command-tree.
  *
+ * Once interned, which happens when the command-tree is frozen, the strings are moved into the string pool of the tree instead.
+ * Every string in the pool is preceded by its length as an unaligned `uint32_t`, so flags can be compared by length first.
+ * Identical strings share a single entry of the pool.
+ *
+ * A borrowing notation, made through `command_init_borrowed()` or `option_init_borrowed()`, stores the pointers of the caller as-is
+ * instead of copying the strings, and never frees them. Those strings need to outlive the notation, like string literals do.
+ *
+ * Short names are also copied into `short_names`, so matching a flag against a notation with at most three aliases
+ * that are all shorter than `NOTATION_SHORT_NAME_SIZE` doesn't follow any pointer. These copies are kept inside the
+ * structure itself, instead of pointed at, since commands and their notations are moved around by value.
+ *
  * For functionality and usage of this structure, look into the `notation.h` header-file.
  */
 typedef struct notation_
@@ -66,8 +262,84 @@ typedef struct notation_
     char* main_name;
     char** aliases;
     char* description;
+    bool is_interned; /**< whether the strings live in a string pool and are not owned by the notation. */
+    bool is_borrowed; /**< whether the strings are the caller's and are not owned by the notation. */
+    unsigned char short_name_count; /**< the amount of names in `short_names`, _0_ when any of the names doesn't fit. */
+    char short_names[NOTATION_SHORT_NAME_COUNT][NOTATION_SHORT_NAME_SIZE];
 } notation_s;
 
+/**
+ * This structure holds the allowed values of an `OPTION_TYPE_CHOICE` option.
+ *
+ * The choices are mapped to their index through a perfect hash, built when the choices are registered:
+ * `slots[perfect_hash_slot(value, displacements)]` holds the index of the only choice that can match plus one, or _0_ when none can.
+ * So resolving a value takes one hash and at most one string compare. Both arrays grow linearly with the amount of choices.
+ *
+ * The structure, the names, the slots and the displacements share a single heap-allocation owned by the option.
+ *
+ * For functionality and usage of this structure, look into the `option.h` header-file.
+ */
+typedef struct option_choices_
+{
+    size_t count;
+    char** names;      /**< the choices in the order they were registered. */
+    size_t slot_count; /**< the amount of slots in `slots`, a power of two. */
+    uint32_t* slots;
+    size_t bucket_count;     /**< the amount of displacements, a power of two. */
+    uint32_t* displacements; /**< per bucket of choices, moves all of its choices into slots of their own. */
+} option_choices_s;
+
+/**
+ * Converts **length** characters of **text** into **value**, which points at `option_type_vtable_s::value_size` bytes.
+ * Returns _false_ when the text isn't a valid value, which is reported as `DIAGNOSTIC_INVALID_VALUE`.
+ */
+typedef bool (*option_type_parse_f)(const char* text, size_t length, void* value, void* context);
+
+/**
+ * Fills **value** with the default of the type, used when an option is initialized without a default.
+ */
+typedef void (*option_type_default_f)(void* value, void* context);
+
+/**
+ * Writes **value** as text into **buffer**, with the same return value and truncation as `snprintf()`.
+ */
+typedef int (*option_type_format_f)(const void* value, char* buffer, size_t buffer_length, void* context);
+
+/**
+ * Frees whatever **value** owns, the memory of **value** itself is owned by the option.
+ */
+typedef void (*option_type_clean_f)(void* value, void* context);
+
+struct option_;
+
+/**
+ * The signature of the callback of a streaming `OPTION_TYPE_MULTI_STRING` option, see `option_set_stream()`.
+ * **values** holds the next **value_count** values of the option and is only valid during the call.
+ * Return _false_ to stop reading any further values.
+ */
+typedef bool (*option_stream_f)(const struct option_* option, const char* const* values, size_t value_count, void* context);
+
+/**
+ * This structure describes a user-defined option type, so values like addresses or ranges are converted once while parsing
+ * instead of being re-parsed from text by every reader.
+ *
+ * The address of the vtable is the runtime id of the type: `option_read_custom()` only hands out a value
+ * to a caller passing the same vtable. The vtable is not copied, so it has to outlive every option using it.
+ * Only `parse` and `value_size` are required, the other functions are optional.
+ *
+ * For functionality and usage of this structure, look into the `option.h` header-file.
+ */
+typedef struct option_type_vtable_
+{
+    const char* name;  /**< the name of the type, shown in the help-descriptor and in diagnostics. */
+    size_t value_size; /**< the size of a converted value. */
+    option_type_parse_f parse;
+    option_type_default_f init_default; /**< when _NULL_, the default is zero-filled. */
+    option_type_format_f format;        /**< when _NULL_, the help doesn't show the default. */
+    option_type_clean_f clean;
+    void* context;     /**< passed to every function of the vtable. */
+} option_type_vtable_s;
+
 /**
  * This is the option structure. This structure is used to specify extra data in a command or expect typed info.
  * Say for example you have a command, and that command has different (optional) extra parameters.
@@ -79,16 +351,33 @@ typedef struct notation_
  *  - FLOATING-POINT NUMBER
  *  - STRING
  *  - MULTI-STRING
+ *  - CHOICE
+ *  - SIZE
+ *  - DURATION
+ *  - CUSTOM, a user-defined type described by an `option_type_vtable_s`
  *
  * `set_value` is also always heap-allocated to hold the typed data:
  *  - `OPTION_TYPE_BOOL`: the size of a boolean.
  *  - `OPTION_TYPE_INT`: the size of an integer.
  *  - `OPTION_TYPE_FLOAT`: the size of a float.
- *  - `OPTION_TYPE_STRING`: the size of a pointer to a string, so not the string itself.
- *  - `OPTION_TYPE_MULTI_STRING`: the length of the string-array passed to the option, again also not the strings themselves.
+ *  - `OPTION_TYPE_STRING`: a growable array of pointers to the passed strings, so not the strings themselves.
+ *  - `OPTION_TYPE_MULTI_STRING`: a growable, NULL-terminated array of pointers to the passed strings, again also not the strings themselves.
+ *  - `OPTION_TYPE_CHOICE`: the size of an integer, holding the index of the passed choice.
+ *  - `OPTION_TYPE_SIZE`: a `uint64_t` holding the amount of bytes.
+ *  - `OPTION_TYPE_DURATION`: a `uint64_t` holding the amount of nanoseconds.
+ *  - `OPTION_TYPE_CUSTOM`: a block of `option_type_vtable_s::value_size` bytes. Whatever the value owns is released through `clean` of the vtable.
+ *
+ * The string-arrays grow geometrically and are tracked with `value_count` and `value_capacity`, so accumulating
+ * an option that is repeated many times costs amortized O(1) per occurrence.
  *
  * `set_value` is free'd when the command-tree is cleaned.
  *
+ * The option stays a single record, also once frozen, as it's the handle `command_find_option()` and `command_get_option()`
+ * give out. It isn't split into parallel arrays of types, flags and values. Instead, the data a parse scans through
+ * lives apart from the options in dense arrays of the command: the name tags and lengths in the lanes of its `option_index`,
+ * and the required, present and defaulted state in its option bitsets. A parse only touches the record of an option
+ * that was passed, or whose tag and length match a passed flag.
+ *
  * For functionality and usage of this structure, look into the `option.h` header-file.
  */
 typedef struct option_
@@ -97,6 +386,10 @@ typedef struct option_
     arguments_s parsed_arguments;
 
     bool is_required;
+    bool is_borrowed; /**< whether the default strings are the caller's, set by `option_init_borrowed()`. Its notation borrows as well. */
+    option_repeat_policy_e repeat_policy;
+    size_t occurrence_count; /**< the amount of times the option was passed. */
+    bool is_overridden; /**< whether the value was set by `option_set_value()` after parsing, instead of read from argv. */
 
     option_type_e type;
     union {
@@ -105,14 +398,103 @@ typedef struct option_
         float float_value;
         char*  string_value;
         char** multi_string_value;
-    } default_value;
+        void*  custom_value;
+        uint64_t size_value;     /**< in bytes. */
+        uint64_t duration_value; /**< in nanoseconds. */
+    } default_value; /**< `int_value` holds the index of the default choice for `OPTION_TYPE_CHOICE`, `custom_value` the owned default of `OPTION_TYPE_CUSTOM`. */
+    option_choices_s* choices; /**< the allowed values of an `OPTION_TYPE_CHOICE` option, _NULL_ for every other type. */
+    const option_type_vtable_s* custom_type; /**< the conversion functions of an `OPTION_TYPE_CUSTOM` option, _NULL_ for every other type. */
     void* set_value; /**< the member holding the passed information, NULL when the flag wasn't called. */
+    size_t value_count;
+    size_t value_capacity;
+
+    option_stream_f stream_callback; /**< set by `option_set_stream()`, the values of a streaming option are handed to it in chunks. */
+    void* stream_context;
+    char stream_delimiter; /**< the byte separating the values read from a stream, `'\0'` or `'\n'`. */
 } option_s;
 
+#define POSITIONAL_UNBOUNDED ((size_t)-1) /**< the maximum count of a variadic positional, which takes every remaining parameter. */
+
+/**
+ * This is the positional structure. A command holds its positionals in declaration order, and while parsing
+ * its parameters are handed out to them from left to right: every positional takes as many parameters as it can,
+ * up to `max_count`, while leaving enough for the `min_count` of the positionals after it.
+ * Only the last positional of a command can be variadic.
+ *
+ * The parameters are converted to `type` in the same pass, `values` holds the results of the last parse.
+ * Only `OPTION_TYPE_INT`, `OPTION_TYPE_FLOAT`, `OPTION_TYPE_STRING`, `OPTION_TYPE_SIZE` and `OPTION_TYPE_DURATION` are supported.
+ *
+ * For functionality and usage of this structure, look into the `positional.h` header-file.
+ */
+typedef struct positional_
+{
+    char* name;
+    bool is_borrowed; /**< whether `name` is the caller's, set by `positional_init_borrowed()`. */
+    option_type_e type;
+    size_t min_count;
+    size_t max_count; /**< `POSITIONAL_UNBOUNDED` for a variadic positional. */
+
+    void* values; /**< an array of `int`, `float`, `char*` or `uint64_t` depending on `type`. The strings point into argv. */
+    size_t value_count;
+    size_t value_capacity;
+} positional_s;
+
+/**
+ * This is the constraint structure. It holds a relationship between options of the same command, declared by their flags.
+ *
+ * The flags are resolved to option indices when the constraint is added, and compiled into `mask` when the command is frozen
+ * or, for a command that never is, on its first parse:
+ * a bitset over the option indices, like `command_s::present_options`, so checking the constraint after parsing
+ * comes down to a few word operations against the options that were passed.
+ * The flags are only looked at again to fill `related_flags` when the constraint is violated.
+ *
+ * For functionality and usage of this structure, look into the `command.h` header-file.
+ */
+typedef struct constraint_
+{
+    constraint_kind_e kind;
+    size_t option_count;
+    size_t* option_indices; /**< the options of the constraint, the option that requires the others comes first for `CONSTRAINT_REQUIRES`. */
+    uint64_t* mask;         /**< the options as a bitset, without the requiring option for `CONSTRAINT_REQUIRES`. _NULL_ until it's compiled. */
+    const char** related_flags; /**< the flags the diagnostic of the last violation points to, shares the allocation of `option_indices`. */
+} constraint_s;
+
+struct command_;
+struct command_tree_;
+
+/**
+ * The signature of a command handler, called by `command_tree_run()` once the command is parsed.
+ * The return value is passed on as the result of `command_tree_run()`, like an exit-code.
+ * The handler is only called when parsing didn't report any errors, warnings don't stop it.
+ * Otherwise `command_tree_run()` returns `COMMAND_TREE_RUN_FAILURE` and leaves the diagnostics in the called command.
+ */
+typedef int (*command_handler_f)(const struct command_tree_* tree, struct command_* command, void* context);
+
 /**
  * This is the command structure. This structure is used to indicate the expected logic of the application by the caller/callee.
  * It holds an array of options denoted by: `option_capacity`, `option_count`, and the `options` array.
+ * The `options` array grows geometrically when options are added beyond its capacity.
  * The parameters that were used when calling the command are stored in `parsed_arguments`.
+ * The `handler` with its `handler_context` is what `command_tree_run()` dispatches to when this command is called.
+ *
+ * Next to the options, the command keeps three bitsets indexed by option position, all living in a single allocation:
+ *  - `required_options`: the options that are required.
+ *  - `present_options`: the options that were passed, updated while parsing.
+ *  - `defaulted_options`: the options that fall back to their default value after parsing.
+ *
+ * Once frozen, the names of its options have been validated, the `options` array is shrunk to fit and no more options can be added.
+ *
+ * The parameters are handed out to the typed `positionals` of the command in the same pass, see `positional_s`.
+ * Unknown flags and the values an option rejected are still kept as parameters, but never handed to a positional:
+ * they come after the other parameters, in the order they were passed.
+ *
+ * Parsing stops at the end-of-options marker `--`. Everything after it is exposed as the `passthrough` slice of argv as-is,
+ * without looking at any of those arguments, so a long tail meant for another program costs nothing to parse.
+ *
+ * A command called through a command-tree also resolves the global options of that tree through `globals`,
+ * after its own options, so an option of the command shadows a global option of the same name.
+ * `globals` and `stats` are bound by `command_tree_parse_base()` and `command_tree_get_called_command()` rather than when
+ * the command is added, so the tree can be moved or returned by value after it was built.
  *
  * For functionality and usage of this structure, look into the `command.h` header-file.
  */
@@ -120,11 +502,41 @@ typedef struct command_
 {
     notation_s notation;
     arguments_s parsed_arguments;
+    diagnostics_s diagnostics; /**< the problems found while freezing or parsing this command. */
+
+    const char* const* passthrough; /**< the arguments after `--` of the last parse, pointing into argv. _NULL_ when there was no `--`. */
+    size_t passthrough_count;
+
+    command_handler_f handler;
+    void* handler_context;
+    parse_stats_s* stats; /**< the statistics of the command-tree that last called it, _NULL_ when it wasn't. */
+    struct command_* globals; /**< the command holding the global options of the command-tree that last called it, _NULL_ when it wasn't. */
 
     bool is_set;
+    bool is_frozen;
+    bool is_compacted; /**< whether `options` and the bitsets live in the block of the command-tree, which happens when the tree is frozen. */
+    bool is_loaded;    /**< whether the command was loaded from a schema image, its notation and options then point into the image. */
+    bool is_globally_indexed; /**< whether `option_index` holds the global options of its command-tree as well, past its own options. */
     size_t option_capacity;
     size_t option_count;
     option_s* options;
+
+    size_t positional_capacity;
+    size_t positional_count;
+    positional_s* positionals; /**< the typed slots the parameters are parsed into, in declaration order. */
+
+    size_t constraint_capacity;
+    size_t constraint_count;
+    constraint_s* constraints;  /**< the relationships between its options, checked after every parse. */
+    uint64_t* constraint_masks; /**< the block holding the `mask` of every constraint, dropped again when an option or constraint is added. */
+
+    size_t option_index_capacity; /**< the amount of slots in `option_index`, _0_ until the command is frozen. */
+    uint32_t* option_index;       /**< the flag lookup-index of the options, made up of `NOTATION_INDEX_LANES` parallel lanes, see `notation_index_capacity()`. */
+
+    size_t option_word_count; /**< the amount of 64-bit words in each of the option bitsets. */
+    uint64_t* required_options;
+    uint64_t* present_options;
+    uint64_t* defaulted_options;
 } command_s;
 
 /**
@@ -133,17 +545,97 @@ typedef struct command_
  * Since you can't call a tree-root itself, there's no reason for this structure to hold a `notation_s`.
  * For this reason I chose for the root to hold its own description, this description should be the description of the application itself.
  *
+ * The `commands` array grows geometrically when commands are added beyond its capacity.
+ *
+ * Options shared by every command, like `--verbose`, are registered once as global options with `command_tree_add_global_option()`.
+ * They are held by `globals`, a nameless command that is never called itself. Freezing the tree adds them to the lookup-index
+ * of every command, past its own options, so a single probe finds either kind. They are parsed in the same pass
+ * as the options of the called command, so their values are stored once per parse.
+ * Global options can't be required, and a tree with global options can't be stored as a schema image.
+ *
+ * Once frozen, all the commands and their options have been validated and no more commands can be added.
+ * Freezing also compacts the commands and all of their options into a single exact-size block,
+ * so parsing walks through contiguous memory. Likewise the names, aliases and descriptions of every
+ * command and option are interned into the `string_pool`. An option whose notation is shared with another option
+ * keeps its own strings, as the other option may belong to another tree that outlives this one.
+ *
  * For functionality and usage of this structure, look into the `command_tree.h` header-file.
  */
 typedef struct command_tree_
 {
+    bool is_frozen;
     size_t command_capacity;
     size_t command_count;
     arguments_s parsed_arguments;
+    diagnostics_s diagnostics; /**< the problems found while freezing the tree or parsing its base. */
+    size_t called_command_index; /**< the index of the command found by `command_tree_parse_base()`. */
+    parse_stats_s stats;
+
+    size_t command_index_capacity; /**< the amount of slots in `command_index`, _0_ until the tree is frozen. */
+    uint32_t* command_index;       /**< the flag lookup-index of the commands, made up of `NOTATION_INDEX_LANES` parallel lanes, see `notation_index_capacity()`. */
+
+    const void* image;    /**< the schema image the tree was loaded from, its strings and lookup-indices point into it. */
+    size_t image_length;
+    bool image_is_mapped; /**< whether `image` was mapped by `command_tree_map_image()` and gets unmapped when cleaning. */
 
+    char* string_pool;       /**< the interned strings of all the notations, filled in when the tree is frozen. */
+    size_t string_pool_size;
+
+    const char** line_tokens;   /**< the argv made by `command_tree_parse_line()`, reused by every line. The tokens point into the line. */
+    size_t line_token_capacity;
+
+    command_s globals; /**< the nameless command holding the global options. */
     command_s* commands;
+    size_t command_block_size; /**< the size of the single block holding `commands` once frozen or loaded, _0_ before. */
     char* description;
+    bool is_borrowed; /**< whether `description` is the caller's, set by `command_tree_init_borrowed()`. */
 } command_tree_s;
 
+/**
+ * This enum is used by `parse_event_s` to denote what the argument it was yielded for turned out to be.
+ */
+typedef enum parse_event_kind_
+{
+    PARSE_EVENT_OPTION,        /**< A flag of an option of the command, or a global option. `value` is the argument it consumed, if any. */
+    PARSE_EVENT_VALUE,         /**< A single value of the `OPTION_TYPE_MULTI_STRING` option yielded right before it. */
+    PARSE_EVENT_POSITIONAL,    /**< An argument that isn't a flag nor the value of an option. */
+    PARSE_EVENT_UNKNOWN_FLAG,  /**< A flag that isn't an option of the command. */
+    PARSE_EVENT_MISSING_VALUE, /**< A flag of an option that needs a value, without one following it. */
+    PARSE_EVENT_PASSTHROUGH,   /**< An argument after the end-of-options marker `--`, which is never looked at. */
+    MAX_PARSE_EVENT_KIND_COUNT
+} parse_event_kind_e;
+
+/**
+ * This is the structure a `parse_iter_s` yields for every argument, or for every flag together with its value.
+ * The strings point into the argv the iterator was started on.
+ *
+ * For functionality and usage of this structure, look into the `parse_iter.h` header-file.
+ */
+typedef struct parse_event_
+{
+    parse_event_kind_e kind;
+    size_t argv_index;    /**< the index of `text` in the argv of the iterator. */
+    const char* text;     /**< the flag of an option, unknown flag or missing value, otherwise the argument itself. */
+    const char* value;    /**< the value consumed by a `PARSE_EVENT_OPTION`, _NULL_ for a flag, a multi-string option or an option without a value. */
+    const option_s* option; /**< the option of a `PARSE_EVENT_OPTION`, `PARSE_EVENT_VALUE` or `PARSE_EVENT_MISSING_VALUE`, otherwise _NULL_. */
+} parse_event_s;
+
+/**
+ * This is the parse iterator structure. It walks the arguments of a command one at a time, looking them up in the same schema
+ * as `command_parse()` does, without storing any of the results. Every call of `parse_iter_next()` only looks at the
+ * arguments the event it yields is made of, so a huge list of arguments is processed in constant memory while it's being parsed.
+ *
+ * For functionality and usage of this structure, look into the `parse_iter.h` header-file.
+ */
+typedef struct parse_iter_
+{
+    const command_s* command;
+    const char* const* argv;
+    size_t argv_count;
+    size_t next_index;
+    const option_s* multi_option; /**< the multi-string option whose values are being yielded, _NULL_ otherwise. */
+    bool is_passthrough;          /**< whether the end-of-options marker was passed. */
+} parse_iter_s;
+
 #endif // !COMMAND_PARSER__COMMAND_TYPES_H__
 
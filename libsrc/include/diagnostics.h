@@ -0,0 +1,107 @@
+#ifndef COMMAND_PARSER__DIAGNOSTICS_H__
+#define COMMAND_PARSER__DIAGNOSTICS_H__
+
+/** \file diagnostics.h
+ * This is the header file containg the functions to use in combination with the `diagnostics_s` structure.
+ *
+ * The library itself never prints while parsing, problems are collected into a `diagnostics_s` instead.
+ * Use `diagnostics_print()` when they should be shown to the user.
+ */
+
+#include "command_types.h"
+
+#include <stdio.h>
+
+/**
+ * @brief Adds a diagnostic to **diagnostics**.
+ *
+ * @param diagnostics The buffer the diagnostic is added to.
+ * @param code The kind of problem.
+ * @param argv_index The index of the argument causing the problem, or `DIAGNOSTIC_NO_ARGV_INDEX`.
+ * @param flag The flag involved, can be `NULL`. The string is not copied.
+ * @param expected_type The type of the option involved, or `MAX_OPTION_TYPE_COUNT`.
+ *
+ * @return _false_ when **diagnostics** is `NULL` or when growing the buffer fails, otherwise _true_.
+ */
+bool diagnostics_push(diagnostics_s* diagnostics, diagnostic_code_e code, size_t argv_index, const char* flag, option_type_e expected_type);
+
+/**
+ * @brief Adds a `DIAGNOSTIC_INVALID_VALUE` diagnostic for **option** to **diagnostics**.
+ *
+ * Next to the type of **option**, the diagnostic also refers to the choices of an `OPTION_TYPE_CHOICE` option,
+ * so `diagnostic_format()` can list them, or to the vtable of an `OPTION_TYPE_CUSTOM` option to name its type.
+ *
+ * @return _false_ when **diagnostics** or **option** is `NULL` or when growing the buffer fails, otherwise _true_.
+ */
+bool diagnostics_push_invalid_value(diagnostics_s* diagnostics, size_t argv_index, const char* flag, const option_s* option);
+
+/**
+ * @brief Adds a diagnostic for a violated `constraint_s` to **diagnostics**.
+ *
+ * @param diagnostics The buffer to add the diagnostic to.
+ * @param code One of `DIAGNOSTIC_EXCLUSIVE_OPTIONS`, `DIAGNOSTIC_MISSING_DEPENDENCY` or `DIAGNOSTIC_MISSING_ONE_OF`.
+ * @param flag The option that requires the others for `DIAGNOSTIC_MISSING_DEPENDENCY`, otherwise `NULL`.
+ * @param related_flags The other flags involved, listed by `diagnostic_format()`. The array is not copied.
+ * @param related_flag_count The amount of **related_flags**.
+ *
+ * @return _false_ when **diagnostics** is `NULL` or when growing the buffer fails, otherwise _true_.
+ */
+bool diagnostics_push_constraint(diagnostics_s* diagnostics, diagnostic_code_e code, const char* flag,
+                                 const char* const* related_flags, size_t related_flag_count);
+
+/**
+ * @brief Adds all the diagnostics of **src** to **dest**.
+ *
+ * @return _false_ when either is `NULL` or when growing **dest** fails, otherwise _true_.
+ */
+bool diagnostics_append(diagnostics_s* restrict dest, const diagnostics_s* restrict src);
+
+/**
+ * @brief Drops all the collected diagnostics, while keeping the buffer allocated for reuse.
+ */
+void diagnostics_clear(diagnostics_s* diagnostics);
+
+/**
+ * @brief The `diagnostics_s`'s clean function.
+ */
+void diagnostics_clean(diagnostics_s* diagnostics);
+
+/**
+ * @return The amount of collected diagnostics, _0_ when **diagnostics** is `NULL`.
+ */
+size_t diagnostics_count(const diagnostics_s* diagnostics);
+
+/**
+ * @return The diagnostic at **index**, or `NULL` when **index** is out of range.
+ */
+const diagnostic_s* diagnostics_get(const diagnostics_s* diagnostics, size_t index);
+
+/**
+ * @brief Checks if any of the collected diagnostics is an error, as opposed to a warning.
+ *
+ * @return _true_ when at least one diagnostic is not a warning, see `diagnostic_is_warning()`.
+ */
+bool diagnostics_has_errors(const diagnostics_s* diagnostics);
+
+/**
+ * @return _true_ when **code** only indicates a warning, which is the case for `DIAGNOSTIC_REPEATED_OPTION`.
+ */
+bool diagnostic_is_warning(diagnostic_code_e code);
+
+/**
+ * @brief Formats a single diagnostic into a human readable message, without a trailing newline.
+ *
+ * @param diagnostic The diagnostic to format.
+ * @param buffer The buffer the message is written into, can be `NULL` when **buffer_length** is _0_.
+ * @param buffer_length The size of **buffer** in bytes.
+ *
+ * @return The length the complete message would have, like `snprintf()`. A negative value on failure.
+ */
+int diagnostic_format(const diagnostic_s* diagnostic, char* buffer, size_t buffer_length);
+
+/**
+ * @brief Prints every collected diagnostic to **stream**, one per line.
+ */
+void diagnostics_print(FILE* stream, const diagnostics_s* diagnostics);
+
+#endif // !COMMAND_PARSER__DIAGNOSTICS_H__
@@ -0,0 +1,22 @@
+#ifndef COMMAND_PARSER__EXTRA__BITSET_H__
+#define COMMAND_PARSER__EXTRA__BITSET_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define BITSET_WORD_BITS 64
+
+size_t bitset_word_count(size_t bit_count);
+
+void bitset_set(uint64_t* words, size_t index);
+void bitset_reset(uint64_t* words, size_t index);
+bool bitset_test(const uint64_t* words, size_t index);
+void bitset_clear(uint64_t* words, size_t word_count);
+
+size_t bitset_count_and(const uint64_t* words, const uint64_t* mask, size_t word_count);
+bool bitset_any_and_not(const uint64_t* words, const uint64_t* mask, size_t word_count);
+size_t bitset_collect_and_not(const uint64_t* words, const uint64_t* mask, size_t word_count, size_t* indices, size_t index_capacity);
+void bitset_complement(uint64_t* dest, const uint64_t* src, size_t bit_count);
+
+#endif // !COMMAND_PARSER__EXTRA__BITSET_H__
@@ -0,0 +1,10 @@
+#ifndef COMMAND_PARSER__EXTRA__DYNAMIC_ARRAY_H__
+#define COMMAND_PARSER__EXTRA__DYNAMIC_ARRAY_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+bool dynamic_array_reserve(void** data, size_t* capacity, size_t element_size, size_t required_capacity);
+bool dynamic_array_shrink(void** data, size_t* capacity, size_t element_size, size_t count);
+
+#endif // !COMMAND_PARSER__EXTRA__DYNAMIC_ARRAY_H__
@@ -0,0 +1,27 @@
+#ifndef COMMAND_PARSER__EXTRA__LINE_TOKENIZER_H__
+#define COMMAND_PARSER__EXTRA__LINE_TOKENIZER_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Splits a line into shell-style tokens in place, so a line read from a console or a socket can be parsed like argv.
+ *
+ * Tokens are separated by spaces, tabs and line-breaks. A backslash followed by a line-break between tokens
+ * is a separator as well, it never forms a token of its own. Within a token:
+ *  - a backslash takes the next character literally, a backslash followed by a line-break is dropped;
+ *  - single quotes take everything up to the next single quote literally;
+ *  - double quotes do the same, but a backslash in them still escapes `"`, `\` and a line-break;
+ *  - quoted and unquoted parts directly next to each other form a single token, `""` forms an empty token.
+ *
+ * The quotes and escapes are removed by moving the characters of a token forward within the line itself,
+ * and every token is NUL-terminated in place. The tokens point into the line, nothing gets allocated.
+ * So the line needs room for `length + 1` characters, which a NUL-terminated line always has.
+ */
+
+#define LINE_TOKENIZE_ERROR ((size_t)-1)
+
+size_t line_tokenizer_capacity(size_t length);
+size_t line_tokenize(char* line, size_t length, const char** tokens, size_t token_capacity);
+
+#endif // !COMMAND_PARSER__EXTRA__LINE_TOKENIZER_H__
@@ -0,0 +1,24 @@
+#ifndef COMMAND_PARSER__EXTRA__PERFECT_HASH_H__
+#define COMMAND_PARSER__EXTRA__PERFECT_HASH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * A collision-free lookup table for a fixed set of strings, built by hash-and-displace.
+ * The keys are spread over a few buckets, `perfect_hash_build()` then places the largest buckets first and searches
+ * a displacement per bucket that moves all of its keys into free slots. A single seed for every key would need
+ * a table that grows with the square of the key count, a displacement per bucket keeps both arrays linear in it.
+ *
+ * A lookup is a single hash, a read of the displacement of its bucket and a single compare against the key stored
+ * for the slot. The slots hold the index of a key plus one, _0_ marks an empty slot. The keys themselves are not stored.
+ */
+
+size_t perfect_hash_slot_count(size_t key_count);
+size_t perfect_hash_bucket_count(size_t key_count);
+bool perfect_hash_build(const char* const* keys, size_t key_count, uint32_t* slots, size_t slot_count,
+                        uint32_t* displacements, size_t bucket_count);
+size_t perfect_hash_slot(const char* key, size_t length, const uint32_t* displacements, size_t bucket_count, size_t slot_count);
+
+#endif // !COMMAND_PARSER__EXTRA__PERFECT_HASH_H__
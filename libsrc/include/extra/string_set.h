@@ -0,0 +1,32 @@
+#ifndef COMMAND_PARSER__EXTRA__STRING_SET_H__
+#define COMMAND_PARSER__EXTRA__STRING_SET_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * An open-addressing hash set of strings.
+ * The set does not copy the strings it holds, it only stores the passed pointers together with their length and hash.
+ * The strings therefore need to outlive the set.
+ */
+typedef struct string_set_
+{
+    size_t capacity_;
+    size_t count_;
+    uint64_t* hashes_;
+    size_t* lengths_;
+    const char** entries_;
+} string_set_s;
+
+bool string_set_init(string_set_s* set, size_t expected_count);
+void string_set_clean(string_set_s* set);
+
+bool string_set_insert(string_set_s* set, const char* value, size_t length, bool* was_present);
+const char* string_set_find(const string_set_s* set, const char* value, size_t length);
+bool string_set_contains(const string_set_s* set, const char* value, size_t length);
+size_t string_set_count(const string_set_s* set);
+
+uint64_t string_set_hash(const char* value, size_t length);
+
+#endif // !COMMAND_PARSER__EXTRA__STRING_SET_H__
@@ -0,0 +1,22 @@
+#ifndef COMMAND_PARSER__EXTRA__UNIT_SUFFIX_H__
+#define COMMAND_PARSER__EXTRA__UNIT_SUFFIX_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Parsers for whole numbers followed by a unit suffix, like `512MiB` or `1h30m`.
+ * The suffixes are looked up in a table holding the multiplier of every unit, and every step is checked
+ * for overflow, so a value that doesn't fit in 64 bits is rejected instead of wrapping around.
+ *
+ * Sizes are a single number with an optional suffix: `B`, the SI suffixes `kB`/`KB` up to `EB` (powers of 1000)
+ * and the IEC suffixes `KiB` up to `EiB` (powers of 1024).
+ * Durations are one or more numbers each followed by `ns`, `us`, `ms`, `s`, `m` or `h`, like `250ms` or `1h30m`.
+ * Only `0` may go without a suffix.
+ */
+
+bool unit_suffix_parse_size(const char* text, size_t length, uint64_t* bytes);
+bool unit_suffix_parse_duration(const char* text, size_t length, uint64_t* nanoseconds);
+
+#endif // !COMMAND_PARSER__EXTRA__UNIT_SUFFIX_H__
@@ -0,0 +1,53 @@
+#ifndef COMMAND_PARSER__MEMORY_USAGE_H__
+#define COMMAND_PARSER__MEMORY_USAGE_H__
+
+/** \file memory_usage.h
+ * This is the header file containg the functions to report the heap memory held by a `command_tree_s` or `command_s`.
+ *
+ * Every allocation is counted with the size it was requested with, so the numbers add up to what a counting allocator sees,
+ * without the bookkeeping overhead of the allocator itself. Memory that isn't owned by the library is not counted:
+ * the structures passed in by the caller, a schema image the tree was loaded from and whatever a value of an
+ * `OPTION_TYPE_CUSTOM` option owns through its `option_type_vtable_s`.
+ *
+ * The notation and defaults of an option are shared between all the copies of that option.
+ * The usage of a command-tree counts them once, while the usage of a single command always counts them.
+ */
+
+#include "command_types.h"
+
+#include <stdio.h>
+
+/**
+ * @brief Adds up the bytes held by **tree**, including all of its commands and options.
+ *
+ * @param tree The command-tree to measure.
+ * @param usage The structure the bytes are written into, per category.
+ *
+ * @return _false_ when either is `NULL`, otherwise _true_.
+ */
+bool command_tree_memory_usage(const command_tree_s* tree, memory_usage_s* usage);
+
+/**
+ * @brief Adds up the bytes held by **command**, including all of its options.
+ *
+ * Once the command-tree is frozen, the commands and options themselves live in a single block of the tree
+ * and are only part of `command_tree_memory_usage()`.
+ *
+ * @param command The command to measure.
+ * @param usage The structure the bytes are written into, per category.
+ *
+ * @return _false_ when either is `NULL`, otherwise _true_.
+ */
+bool command_memory_usage(const command_s* command, memory_usage_s* usage);
+
+/**
+ * @brief The name of **category** as used by `memory_usage_dump()`, or `NULL` when out of range.
+ */
+const char* memory_usage_category_name(memory_usage_category_e category);
+
+/**
+ * @brief Prints **usage** to **stream**, one `name bytes` pair per line followed by the total.
+ */
+void memory_usage_dump(FILE* stream, const memory_usage_s* usage);
+
+#endif // !COMMAND_PARSER__MEMORY_USAGE_H__
@@ -6,6 +6,7 @@
  */
 
 #include "command_types.h"
+#include "extra/string_set.h"
 
 #include <stdarg.h>
 
@@ -17,6 +18,9 @@
  * @param alias_n The length of the va-list **aliases**. Value is allowed to be _0_.
  * @param aliases A va-list of `const char*` items with a length of **alias_n**.
  *
+ * When `notation_s::is_borrowed` is set beforehand, the names are stored as-is instead of being copied.
+ * Only the array holding the aliases is still allocated.
+ *
  * @return
  * _false_ when **notation** or **main_name** is `NULL`.  
  * _false_ when **main_name** is invalid as described by `notation_is_valid_flag()`.  
@@ -31,6 +35,8 @@ bool notation_init(notation_s* notation, const char* main_name, size_t alias_n,
  * @param notation The notation whose description member will be set.
  * @param description The description whose value it's going to be set with.
  *
+ * Like the names, the description is stored as-is when `notation_s::is_borrowed` is set.
+ *
  * @return
  * _false_ when either **notation** or **description** is `NULL`.  
  * _false_ when `strdup()` fails.
@@ -67,5 +73,106 @@ bool notation_has_value(const notation_s* notation, const char* value);
  */
 bool notation_is_valid_flag(const char* value);
 
+/**
+ * @brief Registers the main name and all the aliases of **notation** into the set **names**.
+ *
+ * Used when freezing a command or command-tree to detect conflicting flags in a single pass.
+ * Every conflict that's found is added to **diagnostics**, the function does not stop at the first one.
+ *
+ * @param notation The notation whose names are going to be registered.
+ * @param names The set holding all the names that were already registered within the same scope.
+ * @param diagnostics The buffer the conflicts are reported to, can be `NULL`.
+ *
+ * @return
+ * _false_ when **notation** has no main name, or holds an alias that was discarded by `notation_init()` for being invalid.  
+ * _false_ when any of the names was already part of **names**.  
+ * _false_ on allocation failure of **names**.  
+ * _true_ when none of the aforementioned apply.
+ */
+bool notation_register_names(const notation_s* notation, string_set_s* names, diagnostics_s* diagnostics);
+
+/**
+ * @brief Copies the main name and aliases of **notation** into its inline `short_names`.
+ *
+ * Done by `notation_init()`, only needs to be called again when the names are set in another way.
+ * When there are more than three aliases, or any of the names doesn't fit, no names are copied and
+ * `notation_has_value()` compares the heap-allocated names instead.
+ *
+ * @param notation The notation whose names are copied.
+ */
+void notation_store_short_names(notation_s* notation);
+
+/**
+ * @brief The size of the length that precedes every string in a string pool.
+ */
+#define NOTATION_POOL_PREFIX_SIZE sizeof(uint32_t)
+
+/**
+ * @brief Adds the space the strings of **notation** need within a string pool to **pool_size**.
+ *
+ * Strings that are already part of **seen** don't need any extra space, as they are stored only once.
+ *
+ * @param notation The notation whose strings are measured, skipped when it's already interned.
+ * @param seen The set holding every string measured so far.
+ * @param pool_size The size of the pool so far, in bytes.
+ *
+ * @return _false_ on allocation failure of **seen**, otherwise _true_.
+ */
+bool notation_measure_pooled(const notation_s* notation, string_set_s* seen, size_t* pool_size);
+
+/**
+ * @brief Moves the strings of **notation** into the string pool **pool**, freeing the originals.
+ *
+ * A string that's already part of **pooled** is shared instead of copied again.
+ * **pooled** needs to be initialized for at least the amount of unique strings measured with `notation_measure_pooled()`,
+ * so inserting into it never needs to allocate.
+ *
+ * @param notation The notation to intern, skipped when it's already interned.
+ * @param pooled The set holding the strings already written into **pool**.
+ * @param pool The string pool.
+ * @param pool_used The amount of bytes of **pool** that are in use, updated as strings are added.
+ */
+void notation_intern(notation_s* notation, string_set_s* pooled, char* pool, size_t* pool_used);
+
+/**
+ * @brief The amount of parallel `uint32_t` lanes of a flag lookup-index.
+ *
+ * The first lane holds the entries, the second the tags of the hashed names and the third the lengths of the names.
+ * Probing compares the dense tag and length lanes first, so only a likely match dereferences its notation.
+ */
+#define NOTATION_INDEX_LANES 3
+
+/**
+ * @brief Calculates the amount of slots for a flag lookup-index holding **name_count** names.
+ *
+ * A flag lookup-index is an open-addressing table of `uint32_t` slots, where every name of a notation
+ * maps onto a slot holding the 1-based position of its owner. An empty slot holds _0_.
+ * The lookup-indices are built when freezing, so finding a flag doesn't have to scan every notation.
+ * An index takes up `NOTATION_INDEX_LANES` times the amount of slots in words.
+ *
+ * @return A power of two that keeps the load-factor at or below 0.5.
+ */
+size_t notation_index_capacity(size_t name_count);
+
+/**
+ * @brief Inserts the main name and all the aliases of **notation** into the lookup-index **slots**.
+ *
+ * @param slots The lookup-index, holding **capacity** slots in each of its lanes.
+ * @param capacity The amount of slots as given by `notation_index_capacity()`.
+ * @param notation The notation whose names are inserted.
+ * @param entry The 1-based position of the owner of **notation** that the names map onto.
+ */
+void notation_index_insert(uint32_t* slots, size_t capacity, const notation_s* notation, uint32_t entry);
+
+/**
+ * @return The hash of **flag** used to find its first slot within a lookup-index.
+ */
+uint64_t notation_hash_flag(const char* flag);
+
+/**
+ * @return The tag of **hash** as stored in the second lane of a lookup-index.
+ */
+uint32_t notation_index_tag(uint64_t hash);
+
 #endif // !COMMAND_PARSER__NOTATION_H__
 
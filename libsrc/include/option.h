@@ -17,6 +17,10 @@
  * - `OPTION_TYPE_FLOAT`: Expects an object of type `float*`.
  * - `OPTION_TYPE_STRING`: Expects an object of type `char*`.
  * - `OPTION_TYPE_MULTI_STRING`: Expects an object of type `char**`. Keep in mind that the string-array is NULL-terminated: `{"My", "String", "Array", NULL};`
+ * - `OPTION_TYPE_CHOICE`: Expects an object of type `int*`, the index of the default choice. The choices themselves are set with `option_set_choices()`.
+ * - `OPTION_TYPE_SIZE`: Expects an object of type `uint64_t*`, the amount of bytes.
+ * - `OPTION_TYPE_DURATION`: Expects an object of type `uint64_t*`, the amount of nanoseconds.
+ * - `OPTION_TYPE_CUSTOM`: Not supported, use `option_init_custom()` instead.
  *
  * When initializing as `STRING`/`MULTI_STRING` the option will have ownership of **default_value** as
  * the argument-value gets copied over to the heap.
@@ -32,6 +36,41 @@
  */
 bool option_init(option_s* option, bool is_required, option_type_e option_type, void* default_value);
 
+/**
+ * @brief Initializes the option like `option_init()`, but borrows its strings instead of copying them.
+ *
+ * The string default, the array and strings of a multi-string default, and the names and description set afterwards
+ * are stored as-is and never freed by the library. Meant for static schemas built from string literals,
+ * where this makes constructing and cleaning the option allocate and free nothing but the notation.
+ *
+ * @param option The option that gets initialized by this function.
+ * @param is_required Indicates if the option should be a required option or not.
+ * @param option_type Indicates what type of option this is: see `option_type_e` for possible types.
+ * @param default_value The default value, as described at `option_init()`. Has to outlive the option when it's a string or string-array.
+ *
+ * @return `False` to indicate initialization failure. `True` on success.
+ */
+bool option_init_borrowed(option_s* option, bool is_required, option_type_e option_type, void* default_value);
+
+/**
+ * @brief The init function for an option of a user-defined type, `OPTION_TYPE_CUSTOM`.
+ *
+ * Passed values are converted by `option_type_vtable_s::parse` while parsing, so readers get the converted value
+ * through `option_read_custom()` without parsing any text themselves.
+ *
+ * @param option The option that gets initialized by this function.
+ * @param is_required Indicates if the option should be a required option or not.
+ * @param custom_type The functions of the type, which has to outlive the option.
+ * @param default_text The default as text, converted by the parse function of **custom_type**. When `NULL`, the default
+ * is made by `option_type_vtable_s::init_default` instead.
+ *
+ * @return
+ * `False` when **custom_type** is `NULL`, has no parse function or has a `value_size` of _0_.  
+ * `False` when **default_text** fails to parse, or on allocation failure.  
+ * `True` on success.
+ */
+bool option_init_custom(option_s* option, bool is_required, const option_type_vtable_s* custom_type, const char* default_text);
+
 /**
  * @brief Through this function, you can assign the main name and aliases to the option.
  *
@@ -56,6 +95,103 @@ bool option_set_name(option_s* option, const char* name, size_t alias_n, ...);
  */
 bool option_set_description(option_s* option, const char* description);
 
+/**
+ * @brief Sets what happens when the option is passed more than once.
+ *
+ * Needs to be called before the option is added to a command, as the command holds its own copy of the option.
+ *
+ * @param option The option whose repeat policy will be set.
+ * @param repeat_policy The policy, see `option_repeat_policy_e` for the possible policies.
+ *
+ * @return
+ * `False` when **repeat_policy** is `OPTION_REPEAT_COUNT` and the option is not of `OPTION_TYPE_BOOL`.  
+ * `False` when **repeat_policy** is `OPTION_REPEAT_ACCUMULATE` and the option is not of `OPTION_TYPE_STRING` or `OPTION_TYPE_MULTI_STRING`.  
+ * `True` on success.
+ */
+bool option_set_repeat_policy(option_s* option, option_repeat_policy_e repeat_policy);
+
+#define OPTION_STREAM_MARKER "-" /**< the value that makes a streaming option read its values from a stream. */
+
+/**
+ * @brief Makes an `OPTION_TYPE_MULTI_STRING` option take its values from a stream when it's passed `-`.
+ *
+ * Like in `find -print0 | tool --files -`, the values then don't have to fit in the argv of the process.
+ * After parsing, `option_stream_values()` reads them as records separated by **delimiter**,
+ * and hands them to **callback** a chunk at a time from a buffer of bounded size, so processing starts before the input ends.
+ * Values passed in argv are handed to **callback** the same way, so the caller doesn't need to tell them apart.
+ *
+ * Needs to be called before the option is added to a command, as the command holds its own copy of the option.
+ *
+ * @param option The option that gets to stream its values.
+ * @param delimiter The byte ending every value in the stream, `'\0'` for the output of `find -print0`, or `'\n'` for lines.
+ * @param callback The function the values are handed to.
+ * @param context Passed on to **callback** as-is.
+ *
+ * @return
+ * `False` when the option is not of `OPTION_TYPE_MULTI_STRING`, when **callback** is `NULL` or when **delimiter** is neither `'\0'` nor `'\n'`.  
+ * `True` on success.
+ */
+bool option_set_stream(option_s* option, char delimiter, option_stream_f callback, void* context);
+
+/**
+ * @brief Whether **argument** is `OPTION_STREAM_MARKER` and **option** streams its values.
+ */
+bool option_is_stream_marker(const option_s* option, const char* argument);
+
+/**
+ * @brief The amount of **arguments** an occurrence of **option** takes as its values, the same amount `option_parse()` consumes.
+ *
+ * Used to skip the values of an occurrence that gets ignored, so they aren't mistaken for parameters.
+ *
+ * @param option The option the occurrence belongs to.
+ * @param argument_count The amount of arguments in **arguments**.
+ * @param arguments The arguments following the flag of the occurrence.
+ *
+ * @return _0_ when **option** is `NULL`.
+ */
+size_t option_count_values(const option_s* option, size_t argument_count, const char* const* arguments);
+
+/**
+ * @brief The size of a single converted value of **type**.
+ * For `OPTION_TYPE_STRING` and `OPTION_TYPE_MULTI_STRING` that's the size of one pointer to a string,
+ * for `OPTION_TYPE_CUSTOM` it's the `value_size` of **custom_type**.
+ *
+ * @param type The type of the value.
+ * @param custom_type The user-defined type when **type** is `OPTION_TYPE_CUSTOM`, otherwise ignored.
+ *
+ * @return _0_ when **type** is out of range, or when it's `OPTION_TYPE_CUSTOM` and **custom_type** is `NULL`.
+ */
+size_t option_value_size(option_type_e type, const option_type_vtable_s* custom_type);
+
+/**
+ * @brief Sets the values an `OPTION_TYPE_CHOICE` option accepts.
+ *
+ * The choices are copied and a perfect hash is built over them, so a passed value is resolved to its index
+ * with one hash and a single compare. Parsing a value that isn't one of the choices fails with `DIAGNOSTIC_INVALID_VALUE`.
+ *
+ * @param option The option whose choices will be set.
+ * @param choice_n The amount of choices in the next variadic parameter.
+ * @param ... The choices, expected as individual strings. They are read back by their index in this list.
+ *
+ * @return
+ * `False` when the option is not of `OPTION_TYPE_CHOICE`, or when **choice_n** is _0_.  
+ * `False` when a choice is `NULL` or passed more than once, or when the default index is not below **choice_n**.  
+ * `False` on allocation failure.  
+ * `True` on success.
+ */
+bool option_set_choices(option_s* option, size_t choice_n, ...);
+
+/**
+ * @brief Same as `option_set_choices()`, with the choices passed as an array. Meant for a long or generated list of choices.
+ *
+ * @param option The option whose choices will be set.
+ * @param choice_count The amount of choices in **choices**.
+ * @param choices The choices, copied like those of `option_set_choices()`. They are read back by their index in this array.
+ *
+ * @return The same as `option_set_choices()`, and `False` when **choices** is `NULL`.
+ */
+bool option_set_choice_array(option_s* option, size_t choice_count, const char* const* choices);
+
 /**
  * @brief The cleaner function for the `option_s` structure.
  *
@@ -65,6 +201,33 @@ bool option_set_description(option_s* option, const char* description);
  */
 void option_clean(option_s* option);
 
+/**
+ * @brief Forgets the values, arguments and occurrences a previous parse stored in **option**.
+ *
+ * Called by `command_parse()` for every option of the command, so the same command-tree can parse more than once.
+ *
+ * @param option The option that gets reset.
+ */
+void option_reset(option_s* option);
+
+/**
+ * @brief Overrides the value of **option** after parsing, as if it was passed with **value**.
+ *
+ * **value** is of the same type `option_init()` expects for its default value, except that strings are not copied:
+ * the string of `OPTION_TYPE_STRING` and the strings of the NULL-terminated array of `OPTION_TYPE_MULTI_STRING`
+ * are referenced and have to outlive the option's value, which lasts until the next parse.
+ * A choice is given as its index. `OPTION_TYPE_CUSTOM` isn't supported.
+ *
+ * The values of every previous occurrence are replaced, and the option counts as passed at least once.
+ * Use `command_set_option_value()` to also mark the option as present in its command.
+ *
+ * @param option The option to override.
+ * @param value The new value, see `option_init()` for the type it points to.
+ *
+ * @return _false_ when either is `NULL`, the type is `OPTION_TYPE_CUSTOM`, the choice is out of range or allocating failed, otherwise _true_.
+ */
+bool option_set_value(option_s* option, const void* value);
+
 /**
  * @brief Parses the option starting at the first value in its parsed_arguments::argv_arguments member.
  *
@@ -75,6 +238,14 @@ void option_clean(option_s* option);
  * - `OPTION_TYPE_FLOAT`: Same as `OPTION_TYPE_INT`.
  * - `OPTION_TYPE_STRING`: Same as `OPTION_TYPE_INT`.
  * - `OPTION_TYPE_MULTI_STRING`: Greedy consumes all following arguments until the end or when the next flag is encountered. Returns the amount of arguments consumed, or `-1` when none.
+ * - `OPTION_TYPE_CHOICE`: Same as `OPTION_TYPE_INT`, but returns `-1` when the argument isn't one of the choices.
+ * - `OPTION_TYPE_SIZE`: Same as `OPTION_TYPE_INT`, but returns `-1` when the argument has an unknown suffix or doesn't fit in 64 bits. See `unit_suffix.h` for the suffixes.
+ * - `OPTION_TYPE_DURATION`: Same as `OPTION_TYPE_SIZE`.
+ * - `OPTION_TYPE_CUSTOM`: Same as `OPTION_TYPE_INT`, but returns `-1` when the parse function of its type rejects the argument.
+ *
+ * When the option was already parsed before, the `option_s::repeat_policy` decides if the new occurrence
+ * overrides, gets counted or gets accumulated. With `OPTION_REPEAT_FIRST_WINS` the new occurrence is ignored,
+ * but still consumes its values, see `option_count_values()`.
  *
  * @param option The option that gets parsed
  *
@@ -92,6 +263,13 @@ int option_read_int(const option_s* option);
 float option_read_float(const option_s* option);
 const char* option_read_string(const option_s* option);
 const char** option_read_multi_string(const option_s* option, size_t* count);
+const char** option_read_string_list(const option_s* option, size_t* count);
+size_t option_read_count(const option_s* option);
+int option_read_choice(const option_s* option);
+const char* option_read_choice_name(const option_s* option);
+uint64_t option_read_size(const option_s* option);
+uint64_t option_read_duration(const option_s* option);
+const void* option_read_custom(const option_s* option, const option_type_vtable_s* custom_type);
 
 #endif // !COMMAND_PARSER__OPTION_H__
 
@@ -0,0 +1,43 @@
+#ifndef COMMAND_PARSER__OPTION_STREAM_H__
+#define COMMAND_PARSER__OPTION_STREAM_H__
+
+/** \file option_stream.h
+ * This is the header file containg the functions to hand the values of a streaming option to its callback,
+ * reading them from a stream where the option was passed `OPTION_STREAM_MARKER`. See `option_set_stream()`.
+ *
+ * The records of the stream are read into a buffer of `OPTION_STREAM_CHUNK_SIZE` bytes and handed over
+ * at most `OPTION_STREAM_CHUNK_VALUES` at a time, so the memory used doesn't depend on the length of the stream.
+ * A record that doesn't fit in the buffer by itself, longer than `OPTION_STREAM_CHUNK_SIZE - 1` bytes, stops the reading.
+ * Empty records are skipped, and with `'\n'` as the delimiter a trailing `'\r'` is dropped from every record.
+ */
+
+#include "command_types.h"
+
+#include <stdio.h>
+
+#define OPTION_STREAM_CHUNK_SIZE   65536 /**< the size of the buffer the records are read into, including their NUL-terminators. */
+#define OPTION_STREAM_CHUNK_VALUES 1024  /**< the most values handed to the callback at once. */
+
+/**
+ * @brief Hands all the values of the streaming **option** to its callback, after parsing.
+ *
+ * The values are handed over in the order they were passed. Every `OPTION_STREAM_MARKER` among them is replaced
+ * by the records read from **stream**, up to its end. When the option wasn't passed, its default values are handed over.
+ *
+ * @param option The option whose values are handed over, set up with `option_set_stream()`.
+ * @param stream The stream the records are read from, usually `stdin`.
+ * @param value_count Set to the amount of values handed over, when not `NULL`.
+ *
+ * @return
+ * _false_ when **option** is `NULL` or doesn't stream, or when **stream** is `NULL` while it's needed.  
+ * _false_ when the callback returned _false_, reading from **stream** failed, a record didn't fit in the buffer or allocating the buffer failed.  
+ * _true_ otherwise.
+ */
+bool option_stream_values(const option_s* option, FILE* stream, size_t* value_count);
+
+/**
+ * @brief Finds the option of **command** by **option_flag** and calls `option_stream_values()` on it.
+ */
+bool command_stream_option(const command_s* command, const char* option_flag, FILE* stream, size_t* value_count);
+
+#endif // !COMMAND_PARSER__OPTION_STREAM_H__
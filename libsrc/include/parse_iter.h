@@ -0,0 +1,46 @@
+#ifndef COMMAND_PARSER__PARSE_ITER_H__
+#define COMMAND_PARSER__PARSE_ITER_H__
+
+/** \file parse_iter.h
+ * This is the header file containg the functions to parse the arguments of a command as a stream of `parse_event_s`.
+ *
+ * Where `command_parse()` stores the parameters and the values of every option before the caller gets to see any of them,
+ * the iterator hands out one event per call and allocates nothing. The arguments are classified the same way:
+ *  - A flag of an option, or of a global option, is yielded as `PARSE_EVENT_OPTION` with the argument it consumed as its value.
+ *    `OPTION_TYPE_BOOL` consumes nothing, `OPTION_TYPE_INT` and `OPTION_TYPE_FLOAT` consume the next argument when there is one,
+ *    every other type requires it and yields `PARSE_EVENT_MISSING_VALUE` without it.
+ *  - An `OPTION_TYPE_MULTI_STRING` option is followed by one `PARSE_EVENT_VALUE` per value, up to the next flag.
+ *  - Every other argument is a `PARSE_EVENT_POSITIONAL` or, when it looks like a flag, a `PARSE_EVENT_UNKNOWN_FLAG`.
+ *  - The arguments after `--` are yielded as `PARSE_EVENT_PASSTHROUGH`, the marker itself isn't yielded.
+ *
+ * Values are yielded as text: the iterator doesn't convert or check them, apply repeat policies, positionals or constraints,
+ * and doesn't touch the values stored in the command. Those are left to the caller, which sees every occurrence:
+ * a repeated `OPTION_REPEAT_FIRST_WINS` option is yielded with its value here, where `command_parse()` ignores both.
+ */
+
+#include "command_types.h"
+
+/**
+ * @brief Starts iterating over the arguments of **command**.
+ *
+ * Like the `argv_arguments` of the command, **argv** holds the arguments following the name of the command.
+ * Find the command first with `command_tree_get_command()` when starting from the argv of `main()`.
+ *
+ * @param iter The iterator that gets initialized.
+ * @param command The command whose options the flags are looked up in, it's not modified.
+ * @param argc The amount of arguments in **argv**.
+ * @param argv The arguments to iterate over, they need to outlive the events.
+ *
+ * @return _false_ when **iter** or **command** is `NULL`, when **argc** is negative or when **argv** is `NULL` while **argc** isn't _0_.
+ * Otherwise _true_.
+ */
+bool parse_iter_init(parse_iter_s* iter, const command_s* command, int argc, const char* const* argv);
+
+/**
+ * @brief Yields the next event of **iter** into **event**.
+ *
+ * @return _false_ when **iter** or **event** is `NULL`, or when every argument has been yielded. Otherwise _true_.
+ */
+bool parse_iter_next(parse_iter_s* iter, parse_event_s* event);
+
+#endif // !COMMAND_PARSER__PARSE_ITER_H__
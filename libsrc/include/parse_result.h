@@ -0,0 +1,94 @@
+#ifndef COMMAND_PARSER__PARSE_RESULT_H__
+#define COMMAND_PARSER__PARSE_RESULT_H__
+
+/** \file parse_result.h
+ * This is the header file containg the functions to encode a parsed command into a flat binary blob, and read it back.
+ *
+ * The blob is a single contiguous, position-independent block of memory: every reference inside of it is an offset
+ * from the start of the blob. This makes it possible to hand it over to another process through a pipe or shared memory,
+ * where it can be read in-place through a `parse_result_view_s` without any copies.
+ *
+ * The layout of the blob:
+ *  - A header holding the command index, the counts and the offsets of the sections below.
+ *  - One record per option of the command, in the same order as `command_s::options`, holding the type, presence and the (default) value.
+ *    The records of the global options of the tree follow, so global option `i` is read at option index `option count + i`.
+ *  - The offsets of the positional parameters, the passthrough arguments after `--` and the values of the multi-string options.
+ *    An `OPTION_TYPE_CUSTOM` option stores the text its value was converted from, as its type can't be read by another process.
+ *  - The NUL-terminated string data.
+ *
+ * The blob uses the native byte-order and is meant to be read by the same build of the library.
+ */
+
+#include "command_types.h"
+
+#include <stdint.h>
+
+/**
+ * A read-only view on an encoded parse result. It does not own the blob it points to.
+ */
+typedef struct parse_result_view_
+{
+    const unsigned char* data_;
+    size_t length_;
+    uint32_t command_index_;
+    uint32_t option_count_;
+    uint32_t global_option_count_;
+    uint32_t parameter_count_;
+    uint32_t options_offset_;
+    uint32_t parameters_offset_;
+    uint32_t passthrough_count_;
+    uint32_t passthrough_offset_;
+} parse_result_view_s;
+
+/**
+ * @brief Encodes the parsed **command** of **tree** into **buffer**.
+ *
+ * Works like `snprintf()`: the size required for the complete blob is always returned,
+ * but the blob is only written when **buffer_length** is large enough to hold it.
+ * Call it with a `NULL` **buffer** and _0_ as **buffer_length** to query the required size.
+ *
+ * @param tree The tree **command** is part of, used to determine the command index.
+ * @param command The command whose parse result is encoded, after calling `command_parse()`.
+ * @param buffer The buffer the blob is written into.
+ * @param buffer_length The size of **buffer** in bytes.
+ *
+ * @return The size of the complete blob in bytes, or _0_ when **command** is not part of **tree** or the blob would exceed 4GiB.
+ */
+size_t parse_result_write(const command_tree_s* tree, const command_s* command, void* buffer, size_t buffer_length);
+
+/**
+ * @brief Initializes a view on an encoded parse result, validating its header.
+ *
+ * @param view The view that's going to be initialized.
+ * @param data The start of the blob, as written by `parse_result_write()`.
+ * @param length The amount of bytes available at **data**.
+ *
+ * @return
+ * _false_ when **view** or **data** is `NULL`.  
+ * _false_ when the blob isn't a parse result of this version, or when any of its sections fall outside of **length**.  
+ * _true_ otherwise.
+ */
+bool parse_result_view_init(parse_result_view_s* view, const void* data, size_t length);
+
+size_t parse_result_get_command_index(const parse_result_view_s* view);
+size_t parse_result_get_option_count(const parse_result_view_s* view);
+size_t parse_result_get_global_option_count(const parse_result_view_s* view);
+size_t parse_result_get_parameter_count(const parse_result_view_s* view);
+const char* parse_result_get_parameter(const parse_result_view_s* view, size_t parameter_index);
+size_t parse_result_get_passthrough_count(const parse_result_view_s* view);
+const char* parse_result_get_passthrough(const parse_result_view_s* view, size_t passthrough_index);
+
+bool parse_result_is_option_present(const parse_result_view_s* view, size_t option_index);
+option_type_e parse_result_get_option_type(const parse_result_view_s* view, size_t option_index);
+
+bool parse_result_read_bool(const parse_result_view_s* view, size_t option_index);
+int parse_result_read_int(const parse_result_view_s* view, size_t option_index);
+float parse_result_read_float(const parse_result_view_s* view, size_t option_index);
+int parse_result_read_choice(const parse_result_view_s* view, size_t option_index);
+uint64_t parse_result_read_size(const parse_result_view_s* view, size_t option_index);
+uint64_t parse_result_read_duration(const parse_result_view_s* view, size_t option_index);
+const char* parse_result_read_string(const parse_result_view_s* view, size_t option_index);
+size_t parse_result_read_string_count(const parse_result_view_s* view, size_t option_index);
+const char* parse_result_read_string_at(const parse_result_view_s* view, size_t option_index, size_t string_index);
+
+#endif // !COMMAND_PARSER__PARSE_RESULT_H__
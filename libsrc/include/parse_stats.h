@@ -0,0 +1,90 @@
+#ifndef COMMAND_PARSER__PARSE_STATS_H__
+#define COMMAND_PARSER__PARSE_STATS_H__
+
+/** \file parse_stats.h
+ * This is the header file containg the functions to read the statistics collected by a `command_tree_s`.
+ *
+ * Collecting statistics is compiled out by default, build the library with `COMMAND_PARSER_ENABLE_STATS` defined to turn it on.
+ * When compiled out the instrumentation expands to nothing and `parse_stats_s` stays zeroed.
+ *
+ * While enabled, the time of every phase is measured with a monotonic clock and the counters are updated on the go.
+ * Work is attributed to the command-tree whose phase is running on the current thread, so commands and options
+ * that aren't registered to a tree yet are not accounted for.
+ */
+
+#include "command_types.h"
+
+#include <stdio.h>
+
+/**
+ * @brief Whether the library was built with statistics enabled.
+ */
+bool parse_stats_enabled(void);
+
+/**
+ * @brief Copies the statistics collected by **tree** into **stats**.
+ *
+ * The statistics survive `command_tree_clean()`, so the time spent cleaning can be read afterwards.
+ *
+ * @return _false_ when either is `NULL` or when the library was built without statistics, otherwise _true_.
+ */
+bool command_tree_get_stats(const command_tree_s* tree, parse_stats_s* stats);
+
+/**
+ * @brief Sets all the statistics collected by **tree** back to zero.
+ */
+void command_tree_reset_stats(command_tree_s* tree);
+
+/**
+ * @brief The name of **phase** as used by `parse_stats_dump()`, or `NULL` when out of range.
+ */
+const char* parse_stats_phase_name(parse_stats_phase_e phase);
+
+/**
+ * @brief The name of **counter** as used by `parse_stats_dump()`, or `NULL` when out of range.
+ */
+const char* parse_stats_counter_name(parse_stats_counter_e counter);
+
+/**
+ * @brief Prints **stats** to **stream**, one `name value` pair per line.
+ *
+ * Every phase is printed as `<phase>.ns` and `<phase>.calls`, every counter by its name.
+ * This keeps the output easy to feed into a metrics exporter.
+ */
+void parse_stats_dump(FILE* stream, const parse_stats_s* stats);
+
+/*
+ * The instrumentation used inside of the library.
+ *
+ * `PARSE_STATS_BEGIN()` makes **stats** the statistics of the current thread until the matching `PARSE_STATS_END()`,
+ * passing `NULL` keeps attributing to the statistics of the enclosing phase. Both need to be in the same block.
+ */
+#if defined(COMMAND_PARSER_ENABLE_STATS)
+
+typedef struct parse_stats_frame_
+{
+    parse_stats_s* stats_;
+    parse_stats_s* previous_;
+    parse_stats_phase_e phase_;
+    uint64_t start_;
+} parse_stats_frame_s;
+
+parse_stats_frame_s parse_stats_begin(parse_stats_s* stats, parse_stats_phase_e phase);
+void parse_stats_end(const parse_stats_frame_s* frame);
+void parse_stats_count(parse_stats_counter_e counter, uint64_t amount);
+
+#define PARSE_STATS_BEGIN(stats, phase) parse_stats_frame_s parse_stats_frame_ = parse_stats_begin((stats), (phase))
+#define PARSE_STATS_END() parse_stats_end(&parse_stats_frame_)
+#define PARSE_STATS_COUNT(counter, amount) parse_stats_count((counter), (amount))
+#define PARSE_STATS_ALLOCATION(bytes) (parse_stats_count(PARSE_STATS_ALLOCATIONS, 1), parse_stats_count(PARSE_STATS_ALLOCATED_BYTES, (bytes)))
+
+#else
+
+#define PARSE_STATS_BEGIN(stats, phase) ((void)0)
+#define PARSE_STATS_END() ((void)0)
+#define PARSE_STATS_COUNT(counter, amount) ((void)0)
+#define PARSE_STATS_ALLOCATION(bytes) ((void)0)
+
+#endif // COMMAND_PARSER_ENABLE_STATS
+
+#endif // !COMMAND_PARSER__PARSE_STATS_H__
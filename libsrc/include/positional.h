@@ -0,0 +1,64 @@
+#ifndef COMMAND_PARSER__POSITIONAL_H__
+#define COMMAND_PARSER__POSITIONAL_H__
+
+/** \file positional.h
+ * This is the header file containg the functions to use in combination with the `positional_s` structure.
+ */
+
+#include "command_types.h"
+
+/**
+ * @brief The init function for the `positional_s` structure.
+ *
+ * @param positional The positional that gets initialized by this function.
+ * @param name The name shown in the help and in diagnostics, it's copied.
+ * @param type The type the parameters get converted to. See `positional_s` for the supported types.
+ * @param min_count The amount of parameters that have to be passed for this positional.
+ * @param max_count The most parameters this positional takes, `POSITIONAL_UNBOUNDED` to take every remaining parameter.
+ *
+ * @return
+ * _false_ when **positional** or **name** is `NULL`, when **type** is not supported,
+ * when **max_count** is _0_ or smaller than **min_count**, or when copying **name** fails.  
+ * _true_ otherwise.
+ */
+bool positional_init(positional_s* positional, const char* name, option_type_e type, size_t min_count, size_t max_count);
+
+/**
+ * @brief Initializes the positional like `positional_init()`, but stores **name** as-is instead of copying it.
+ */
+bool positional_init_borrowed(positional_s* positional, const char* name, option_type_e type, size_t min_count, size_t max_count);
+
+void positional_clean(positional_s* positional);
+
+/**
+ * @brief Converts **parameters** into the values of **positional**, replacing those of a previous parse.
+ *
+ * This function is called by `command_parse()` with the parameters handed out to **positional**.
+ * Numbers are only accepted when the whole parameter is a number that fits its type,
+ * sizes and durations follow the suffixes of `unit_suffix.h`.
+ *
+ * @param positional The positional to store the values in.
+ * @param parameters The parameters to convert, they need to outlive the values when the type is `OPTION_TYPE_STRING`.
+ * @param parameter_count The amount of **parameters**.
+ * @param invalid_index Set to the index of the first parameter that isn't valid for the type,
+ * or to **parameter_count** when allocating the values failed.
+ *
+ * @return _false_ when a parameter is invalid or allocating failed, no values are stored then. Otherwise _true_.
+ */
+bool positional_parse(positional_s* positional, const char* const* parameters, size_t parameter_count, size_t* invalid_index);
+
+/**
+ * @brief Forgets the values a previous parse stored in **positional**, keeping their memory for the next parse.
+ */
+void positional_reset(positional_s* positional);
+
+const char* positional_get_name(const positional_s* positional);
+bool positional_is_variadic(const positional_s* positional);
+size_t positional_get_count(const positional_s* positional);
+int positional_read_int(const positional_s* positional, size_t index);
+float positional_read_float(const positional_s* positional, size_t index);
+const char* positional_read_string(const positional_s* positional, size_t index);
+uint64_t positional_read_size(const positional_s* positional, size_t index);
+uint64_t positional_read_duration(const positional_s* positional, size_t index);
+
+#endif // !COMMAND_PARSER__POSITIONAL_H__
@@ -0,0 +1,79 @@
+#ifndef COMMAND_PARSER__SCHEMA_IMAGE_H__
+#define COMMAND_PARSER__SCHEMA_IMAGE_H__
+
+/** \file schema_image.h
+ * This is the header file containg the functions to store a frozen `command_tree_s` as a relocatable schema image, and load it again.
+ *
+ * A schema image holds everything of a frozen tree that doesn't change while parsing: the names, aliases, descriptions,
+ * types, default values and the flag lookup-indices of all the commands and options.
+ * Every reference inside of the image is an offset from its start, so it can be mapped read-only at any address.
+ *
+ * Loading an image does not copy any of its strings or lookup-indices, the tree refers to the image directly.
+ * The only allocation made is a single block holding the command, option and notation structures.
+ * When loaded through `command_tree_map_image()` the image is shared between all the processes mapping the same file.
+ *
+ * Handlers are function pointers and therefore not part of the image, set them again with `command_set_handler()` after loading.
+ * For the same reason a tree holding an `OPTION_TYPE_CUSTOM` option or a streaming option can't be stored as an image.
+ * The image uses the native byte-order and is meant to be loaded by the same build of the library.
+ */
+
+#include "command_types.h"
+
+/**
+ * @brief Writes the schema image of the frozen **tree** into **buffer**.
+ *
+ * Works like `snprintf()`: the size required for the complete image is always returned,
+ * but the image is only written when **buffer_length** is large enough to hold it.
+ *
+ * @param tree The tree to store, it needs to be frozen with `command_tree_freeze()`.
+ * @param buffer The buffer the image is written into, needs to be aligned to at least 8 bytes.
+ * @param buffer_length The size of **buffer** in bytes.
+ *
+ * @return The size of the complete image in bytes, or _0_ when **tree** is not frozen, holds an `OPTION_TYPE_CUSTOM` option,
+ * a streaming option, global options, positionals or constraints, or the image would exceed 4GiB.
+ */
+size_t schema_image_write(const command_tree_s* tree, void* buffer, size_t buffer_length);
+
+/**
+ * @brief Writes the schema image of the frozen **tree** into the file at **path**.
+ *
+ * @return _false_ when the image could not be written, otherwise _true_.
+ */
+bool schema_image_save(const command_tree_s* tree, const char* path);
+
+/**
+ * @brief Initializes **tree** from the schema image at **image**, without copying it.
+ *
+ * The image needs to stay valid and unchanged for as long as **tree** is in use.
+ * Every offset, count and lookup-index slot is checked against the image before it's used, so a damaged image is rejected
+ * instead of being read past its end. The image of a tree without commands loads into an empty tree.
+ * The tree is frozen after loading and is cleaned up with `command_tree_clean()` as usual, which does not free **image**.
+ *
+ * @param tree The tree to initialize.
+ * @param image The image as written by `schema_image_write()`, aligned to at least 8 bytes.
+ * @param length The amount of bytes available at **image**.
+ *
+ * @return
+ * _false_ when the image is invalid, misaligned or of another version.  
+ * _false_ on allocation failure.  
+ * _true_ otherwise.
+ */
+bool command_tree_load_image(command_tree_s* tree, const void* image, size_t length);
+
+/**
+ * @brief Maps the schema image file at **path** read-only into memory and initializes **tree** from it.
+ *
+ * The mapping is released again by `command_tree_clean()`.
+ *
+ * @return _false_ when the file could not be mapped or holds an invalid image, otherwise _true_.
+ */
+bool command_tree_map_image(command_tree_s* tree, const char* path);
+
+/**
+ * @brief Releases a mapping made by `command_tree_map_image()`.
+ *
+ * This function gets called when calling `command_tree_clean()`. So you will rarely need this function.
+ */
+void schema_image_unmap(const void* mapping, size_t length);
+
+#endif // !COMMAND_PARSER__SCHEMA_IMAGE_H__
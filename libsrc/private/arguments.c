@@ -1,5 +1,7 @@
 #include "arguments.h"
 
+#include "parse_stats.h"
+
 #include <stdlib.h>
 
 bool arguments_init(arguments_s* arguments, const char* self, int argc, const char* const* argv_arguments)
@@ -28,7 +30,11 @@ bool arguments_prepare_parameters(arguments_s* arguments)
 
     arguments->parameters = malloc(sizeof(char*) * arguments->argv_count);
     arguments->parameter_count = 0;
-    return arguments->parameters != NULL;
+    if (arguments->parameters == NULL)
+        return false;
+
+    PARSE_STATS_ALLOCATION(sizeof(char*) * arguments->argv_count);
+    return true;
 }
 
 void arguments_clean(arguments_s* arguments)
@@ -3,24 +3,43 @@
 #include "command_tree.h"
 #include "command.h"
 #include "option.h"
+#include "positional.h"
+
+// LOCAL FUNCTION DEFINITIONS //
+
+static int help_command_handler_(const command_tree_s* command_tree, command_s* called_command, void* context);
+static bool run_help_command_(const command_tree_s* command_tree, const command_s* called_command);
+static void print_choices_descriptor_(FILE* stream, const option_choices_s* choices);
+static void print_custom_descriptor_(FILE* stream, const option_s* option);
+static void print_positional_usage_(FILE* stream, const command_s* command);
+static int print_positional_name_(FILE* stream, const positional_s* positional);
+
+// END LOCAL FUNCTION DEFINITIONS //
 
 static const char* HELP_TYPE_DESCRIPTORS[MAX_OPTION_TYPE_COUNT] = {
     [OPTION_TYPE_BOOL]         = "<Flag>",
     [OPTION_TYPE_INT]          = "<Number: 1;2;3>",
     [OPTION_TYPE_FLOAT]        = "<Number: 1.0;2.0>",
     [OPTION_TYPE_STRING]       = "<Text>",
-    [OPTION_TYPE_MULTI_STRING] = "<Multi-Text>"
+    [OPTION_TYPE_MULTI_STRING] = "<Multi-Text>",
+    [OPTION_TYPE_CHOICE]       = "<Choice>",
+    [OPTION_TYPE_SIZE]         = "<Size: 512MiB>",
+    [OPTION_TYPE_DURATION]     = "<Time: 1h30m>",
+    [OPTION_TYPE_CUSTOM]       = "<Value>"
 };
 
+static const char* HELP_STREAM_DESCRIPTOR = "<Multi-Text|->";
+
 bool command_tree_add_help(command_tree_s* command_tree)
 {
     if (command_tree == NULL)
         return false;
 
     command_s help_command = {0};
-    command_init(&help_command, 0);
+    command_init_borrowed(&help_command, 0);
     command_set_name(&help_command, "--help", 1, "-h");
     command_set_description(&help_command, "Shows the commands and options that are available. Call --help <command> to show info about a specific command");
+    command_set_handler(&help_command, help_command_handler_, NULL);
     
     bool success = command_tree_add_command(command_tree, &help_command);
     if (!success)
@@ -38,24 +57,7 @@ bool handle_help_command(const command_tree_s* command_tree, const command_s* ca
     if (!command_is_of_flag(called_command, "--help"))
         return false;
 
-    // print out the global help when no extra parameters were passed
-    if (called_command->parsed_arguments.parameter_count == 0)
-    {
-        print_global_help(stdout, command_tree);
-        return true;
-    }
-
-    // when extra parameters were given
-    const char* target_command_name = *called_command->parsed_arguments.parameters;
-    const command_s* target_command = command_tree_get_command(command_tree, target_command_name);
-
-    if (target_command == NULL)
-    {
-        fprintf(stderr, "Command `%s` could not be found\n", target_command_name);
-        return true;
-    }
-
-    print_command_help(stdout, target_command);
+    run_help_command_(command_tree, called_command);
     return true;
 }
 
@@ -70,6 +72,16 @@ void print_global_help(FILE* stream, const command_tree_s* command_tree)
     fprintf(stream, "Commands:\n");
     for (size_t i = 0; i < command_tree->command_count; ++i)
         print_command_inline_help(stream, &command_tree->commands[i]);
+
+    if (command_tree->globals.option_count <= 0)
+        return;
+
+    fprintf(stream, "\nGlobal options:\n");
+    for (size_t i = 0; i < command_tree->globals.option_count; ++i)
+    {
+        print_option_inline_help(stream, &command_tree->globals.options[i]);
+        fprintf(stream, "\n");
+    }
 }
 
 void print_command_inline_help(FILE* stream, const command_s* command)
@@ -96,20 +108,40 @@ void print_command_help(FILE* stream, const command_s* command)
     else
         fprintf(stream, "%s:\n\n", command_get_name(command));
 
+    if (command->positional_count > 0)
+    {
+        print_positional_usage_(stream, command);
+        fprintf(stream, "Arguments:\n");
+        for (size_t i = 0; i < command->positional_count; ++i)
+        {
+            print_positional_inline_help(stream, &command->positionals[i]);
+            fprintf(stream, "\n");
+        }
+
+        if (command->option_count > 0)
+            fprintf(stream, "\n");
+    }
+
     if (command->option_count <= 0)
         return;
 
     size_t required_count = 0;
+    size_t streaming_count = 0;
     fprintf(stream, "Options:\n");
     for (size_t i = 0; i < command->option_count; ++i)
     {
         required_count += command->options[i].is_required;
+        streaming_count += command->options[i].stream_callback != NULL;
         print_option_inline_help(stream, &command->options[i]);
         fprintf(stream, "\n");
     }
 
+    if (required_count > 0 || streaming_count > 0)
+        fprintf(stream, "\n");
     if (required_count > 0)
-        fprintf(stream, "\n*: required option\n");
+        fprintf(stream, "*: required option\n");
+    if (streaming_count > 0)
+        fprintf(stream, "-: streaming option, pass `-` to read its values from stdin\n");
 }
 
 void print_option_inline_help(FILE* stream, const option_s* option)
@@ -121,10 +153,125 @@ void print_option_inline_help(FILE* stream, const option_s* option)
             option->is_required ? "*" : "",
             option_get_name(option));
 
-    if (HELP_TYPE_DESCRIPTORS[option->type] != NULL)
+    if (option->type == OPTION_TYPE_CHOICE && option->choices != NULL)
+        print_choices_descriptor_(stream, option->choices);
+    else if (option->type == OPTION_TYPE_CUSTOM && option->custom_type != NULL && option->custom_type->name != NULL)
+        print_custom_descriptor_(stream, option);
+    else if (option->stream_callback != NULL)
+        fprintf(stream, "| %-16s ", HELP_STREAM_DESCRIPTOR);
+    else if (HELP_TYPE_DESCRIPTORS[option->type] != NULL)
         fprintf(stream, "| %-16s ", HELP_TYPE_DESCRIPTORS[option->type]);
 
     const char* desc = option_get_description(option);
     if (desc != NULL)
         fprintf(stream, "| %s", desc);
 }
+
+void print_positional_inline_help(FILE* stream, const positional_s* positional)
+{
+    if (stream == NULL || positional == NULL)
+        return;
+
+    // lines up with the names of the options, which are preceded by their required-marker
+    int written = fprintf(stream, "\t ");
+    written += print_positional_name_(stream, positional);
+    fprintf(stream, "%*s ", written - 2 < 15 ? 15 - (written - 2) : 0, "");
+
+    if (HELP_TYPE_DESCRIPTORS[positional->type] != NULL)
+        fprintf(stream, "| %-16s ", HELP_TYPE_DESCRIPTORS[positional->type]);
+
+    if (positional_is_variadic(positional))
+        fprintf(stream, "| %zu or more", positional->min_count);
+    else if (positional->min_count == positional->max_count)
+        fprintf(stream, "| %zu", positional->min_count);
+    else
+        fprintf(stream, "| %zu to %zu", positional->min_count, positional->max_count);
+}
+
+// LOCAL FUNCTION IMPLEMENTATIONS //
+
+int help_command_handler_(const command_tree_s* command_tree, command_s* called_command, void* context)
+{
+    (void)context;
+
+    return run_help_command_(command_tree, called_command) ? 0 : 1;
+}
+
+bool run_help_command_(const command_tree_s* command_tree, const command_s* called_command)
+{
+    // print out the global help when no extra parameters were passed
+    if (called_command->parsed_arguments.parameter_count == 0)
+    {
+        print_global_help(stdout, command_tree);
+        return true;
+    }
+
+    // when extra parameters were given
+    const char* target_command_name = *called_command->parsed_arguments.parameters;
+    const command_s* target_command = command_tree_get_command(command_tree, target_command_name);
+
+    if (target_command == NULL)
+    {
+        fprintf(stderr, "Command `%s` could not be found\n", target_command_name);
+        return false;
+    }
+
+    print_command_help(stdout, target_command);
+    return true;
+}
+
+void print_positional_usage_(FILE* stream, const command_s* command)
+{
+    fprintf(stream, "Usage: %s", command_get_name(command));
+    if (command->option_count > 0)
+        fprintf(stream, " [options]");
+
+    for (size_t i = 0; i < command->positional_count; ++i)
+    {
+        fprintf(stream, " ");
+        print_positional_name_(stream, &command->positionals[i]);
+    }
+
+    fprintf(stream, "\n\n");
+}
+
+int print_positional_name_(FILE* stream, const positional_s* positional)
+{
+    // `<name>` has to be passed, `[name]` can be left out, and `...` takes more than one
+    bool is_required = positional->min_count > 0;
+    return fprintf(stream, "%s%s%s%s",
+                   is_required ? "<" : "[",
+                   positional_get_name(positional),
+                   is_required ? ">" : "]",
+                   positional->max_count > 1 ? "..." : "");
+}
+
+void print_choices_descriptor_(FILE* stream, const option_choices_s* choices)
+{
+    int written = fprintf(stream, "| <");
+    for (size_t i = 0; i < choices->count; ++i)
+        written += fprintf(stream, "%s%s", i > 0 ? "|" : "", choices->names[i]);
+    written += fprintf(stream, ">");
+
+    // pad the same way as the `%-16s` of the other descriptors
+    int descriptor_length = written - 2;
+    fprintf(stream, "%*s ", descriptor_length < 16 ? 16 - descriptor_length : 0, "");
+}
+
+void print_custom_descriptor_(FILE* stream, const option_s* option)
+{
+    const option_type_vtable_s* custom_type = option->custom_type;
+
+    // shows the default the same way as the `<Number: 1;2;3>` descriptor, when the type can format it
+    char default_text[64] = "";
+    if (custom_type->format != NULL && option->default_value.custom_value != NULL &&
+        custom_type->format(option->default_value.custom_value, default_text, sizeof(default_text), custom_type->context) < 0)
+        default_text[0] = '\0';
+
+    int written = fprintf(stream, "| <%s%s%s>", custom_type->name, default_text[0] != '\0' ? ": " : "", default_text);
+
+    int descriptor_length = written - 2;
+    fprintf(stream, "%*s ", descriptor_length < 16 ? 16 - descriptor_length : 0, "");
+}
+
+// END LOCAL FUNCTION IMPLEMENTATIONS //
@@ -2,26 +2,87 @@
 
 #include "option.h"
 #include "notation.h"
+#include "positional.h"
 #include "arguments.h"
+#include "diagnostics.h"
+#include "parse_stats.h"
+#include "extra/dynamic_array.h"
+#include "extra/bitset.h"
 
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 #include <stdarg.h>
 #include <stdint.h>
 
+// LOCAL DEFINITIONS //
+
+static bool command_grow_option_bits_(command_s* command, size_t word_count);
+static void command_finish_parse_(command_s* command);
+static bool command_parse_(command_s* command);
+static option_s* command_find_option_(const command_s* command, const command_s* globals, const char* option_flag, const command_s** owner);
+static const command_s* command_option_owner_(const command_s* command, const option_s* option);
+static bool command_has_globals_(const command_s* command);
+static size_t command_count_option_names_(const command_s* command);
+static size_t command_find_end_of_options_(const command_s* command);
+static void command_parse_positionals_(command_s* command, size_t candidate_count);
+static void command_exclude_parameter_(command_s* command, size_t* excluded_count, const char* argument);
+static void command_append_excluded_(command_s* command, size_t excluded_count);
+static size_t command_argv_index_of_(const command_s* command, const char* argument);
+static bool command_add_constraint_(command_s* command, constraint_kind_e kind, const char* first_flag, size_t flag_n, va_list flags);
+static bool command_compile_constraints_(command_s* command);
+static void command_drop_constraint_masks_(command_s* command);
+static void command_check_constraints_(const command_s* owner, command_s* command);
+
+// END LOCAL DEFINITIONS //
+
 bool command_init(command_s* command, size_t option_capacity)
 {
-    if (command == NULL || option_capacity == 0)
+    if (command == NULL)
         return false;
 
-    command->options = malloc(sizeof(option_s) * option_capacity);
-    if (command->options == NULL)
+    command->options = NULL;
+    command->option_capacity = 0;
+    if (!dynamic_array_reserve((void**)&command->options, &command->option_capacity, sizeof(option_s), option_capacity))
         return false;
 
+    command->notation = (notation_s){0};
+    command->diagnostics = (diagnostics_s){0};
+    command->parsed_arguments = (arguments_s){0};
+    command->passthrough = NULL;
+    command->passthrough_count = 0;
+    command->handler = NULL;
+    command->handler_context = NULL;
+    command->stats = NULL;
+    command->globals = NULL;
     command->is_set = false;
-    command->option_capacity = option_capacity;
+    command->is_frozen = false;
+    command->is_compacted = false;
+    command->is_loaded = false;
+    command->is_globally_indexed = false;
     command->option_count = 0;
+    command->option_word_count = 0;
+    command->required_options = NULL;
+    command->present_options = NULL;
+    command->defaulted_options = NULL;
+    command->option_index_capacity = 0;
+    command->option_index = NULL;
+    command->positionals = NULL;
+    command->positional_count = 0;
+    command->positional_capacity = 0;
+    command->constraints = NULL;
+    command->constraint_count = 0;
+    command->constraint_capacity = 0;
+    command->constraint_masks = NULL;
+    return true;
+}
+
+bool command_init_borrowed(command_s* command, size_t option_capacity)
+{
+    if (!command_init(command, option_capacity))
+        return false;
+
+    // the name, aliases and description are stored as-is, see `notation_s`
+    command->notation.is_borrowed = true;
     return true;
 }
 
@@ -48,6 +109,16 @@ bool command_set_description(command_s* command, const char* description)
     return notation_set_description(&command->notation, description);
 }
 
+bool command_set_handler(command_s* command, command_handler_f handler, void* context)
+{
+    if (command == NULL)
+        return false;
+
+    command->handler = handler;
+    command->handler_context = context;
+    return true;
+}
+
 void command_clean(command_s* command)
 {
     if (command == NULL)
@@ -61,17 +132,54 @@ void command_clean(command_s* command)
         free(command->options);
         command->options = NULL;
     }
+    command->option_count = 0;
+    command->option_capacity = 0;
+
+    free(command->option_index);
+    command->option_index = NULL;
+    command->option_index_capacity = 0;
+
+    // the other bitsets share the allocation of the required bitset
+    free(command->required_options);
+    command->required_options = NULL;
+    command->present_options = NULL;
+    command->defaulted_options = NULL;
+    command->option_word_count = 0;
+
+    for (size_t i = 0; i < command->positional_count; ++i)
+        positional_clean(&command->positionals[i]);
+
+    free(command->positionals);
+    command->positionals = NULL;
+    command->positional_count = 0;
+    command->positional_capacity = 0;
+
+    // the related flags share the allocation of the indices, and every mask lives in the same block
+    for (size_t i = 0; i < command->constraint_count; ++i)
+        free(command->constraints[i].option_indices);
+
+    free(command->constraints);
+    free(command->constraint_masks);
+    command->constraints = NULL;
+    command->constraint_masks = NULL;
+    command->constraint_count = 0;
+    command->constraint_capacity = 0;
 
     notation_clean(&command->notation);
     arguments_clean(&command->parsed_arguments);
+    diagnostics_clean(&command->diagnostics);
 }
 
 bool command_add_option(command_s* command, option_s* option)
 {
-    if (command == NULL)
+    if (command == NULL || command->is_frozen)
         return false;
 
-    if (command->option_count >= command->option_capacity)
+    if (!dynamic_array_reserve((void**)&command->options, &command->option_capacity, sizeof(option_s), command->option_count + 1))
+        return false;
+
+    size_t required_words = bitset_word_count(command->option_count + 1);
+    if (required_words > command->option_word_count && !command_grow_option_bits_(command, required_words))
         return false;
 
     memcpy(&command->options[command->option_count], option, sizeof(option_s));
@@ -81,92 +189,202 @@ bool command_add_option(command_s* command, option_s* option)
         memset(&command->options[command->option_count], 0, sizeof(option_s));
         return false;
     }
+
+    if (option->is_required)
+        bitset_set(command->required_options, command->option_count);
+
     command->option_count++;
     return true;
 }
 
-bool command_parse(command_s* command)
+bool command_add_positional(command_s* command, const char* name, option_type_e type, size_t min_count, size_t max_count)
 {
-    if (command == NULL)
+    if (command == NULL || command->is_frozen || name == NULL)
         return false;
 
-    if (command->parsed_arguments.argv_count == 0)
-        return true;
+    // a variadic positional takes every remaining parameter, so nothing can come after it
+    if (command->positional_count > 0 && positional_is_variadic(&command->positionals[command->positional_count - 1]))
+        return false;
 
-    if (!arguments_prepare_parameters(&command->parsed_arguments))
+    for (size_t i = 0; i < command->positional_count; ++i)
+        if (strcmp(command->positionals[i].name, name) == 0)
+            return false;
+
+    if (!dynamic_array_reserve((void**)&command->positionals, &command->positional_capacity, sizeof(positional_s), command->positional_count + 1))
         return false;
 
+    positional_s* positional = &command->positionals[command->positional_count];
+    bool success = command->notation.is_borrowed
+                   ? positional_init_borrowed(positional, name, type, min_count, max_count)
+                   : positional_init(positional, name, type, min_count, max_count);
+    if (!success)
+        return false;
 
-    if (command->option_count == 0)
-    {
-        for (size_t i = 0; i < command->parsed_arguments.argv_count; ++i)
-            command->parsed_arguments.parameters[i] = command->parsed_arguments.argv_arguments[i];
+    command->positional_count++;
+    return true;
+}
+
+bool command_add_exclusive_group(command_s* command, size_t flag_n, ...)
+{
+    va_list flags;
+    va_start(flags, flag_n);
+    bool success = flag_n >= 2 && command_add_constraint_(command, CONSTRAINT_EXCLUSIVE, NULL, flag_n, flags);
+    va_end(flags);
+    return success;
+}
+
+bool command_add_requirement(command_s* command, const char* option_flag, size_t required_n, ...)
+{
+    va_list flags;
+    va_start(flags, required_n);
+    bool success = option_flag != NULL && required_n >= 1 &&
+                   command_add_constraint_(command, CONSTRAINT_REQUIRES, option_flag, required_n, flags);
+    va_end(flags);
+    return success;
+}
+
+bool command_add_at_least_one_group(command_s* command, size_t flag_n, ...)
+{
+    va_list flags;
+    va_start(flags, flag_n);
+    bool success = flag_n >= 1 && command_add_constraint_(command, CONSTRAINT_AT_LEAST_ONE, NULL, flag_n, flags);
+    va_end(flags);
+    return success;
+}
 
-        command->parsed_arguments.parameter_count = command->parsed_arguments.argv_count;
+bool command_freeze(command_s* command)
+{
+    if (command == NULL)
+        return false;
+
+    if (command->is_frozen)
         return true;
-    }
 
-    for (int64_t i = 0; i < (int64_t)command->parsed_arguments.argv_count; ++i)
+    size_t name_count = command_count_option_names_(command);
+    diagnostics_clear(&command->diagnostics);
+
+    string_set_s option_names = {0};
+    if (!string_set_init(&option_names, name_count))
     {
-        bool arg_is_flag = notation_is_valid_flag(command->parsed_arguments.argv_arguments[i]);
-        // when argument is not a flag
-        if (!arg_is_flag)
-        {
-            command->parsed_arguments.parameters[command->parsed_arguments.parameter_count] =
-                command->parsed_arguments.argv_arguments[i];
+        diagnostics_push(&command->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
 
-            command->parsed_arguments.parameter_count++;
-            continue;
-        }
+    // keep going after the first conflict so every conflict gets reported
+    bool is_valid = true;
+    for (size_t i = 0; i < command->option_count; ++i)
+    {
+        const notation_s* notation = shared_value_read_const(&command->options[i].shared_notation);
+        if (!notation_register_names(notation, &option_names, &command->diagnostics))
+            is_valid = false;
+    }
 
-        // when the argument is a flag, but not used by any options within this command
-        option_s* found_option = command_find_option(command, command->parsed_arguments.argv_arguments[i]);
-        if (found_option == NULL)
-        {
-            fprintf(stderr, "Found unknown option `%s`\n", command->parsed_arguments.argv_arguments[i]);
-            command->parsed_arguments.parameters[command->parsed_arguments.parameter_count] =
-                command->parsed_arguments.argv_arguments[i];
+    string_set_clean(&option_names);
+    if (!is_valid)
+        return false;
 
-            command->parsed_arguments.parameter_count++;
-            continue;
-        }
+    if (!dynamic_array_shrink((void**)&command->options, &command->option_capacity, sizeof(option_s), command->option_count))
+        return false;
 
-        if (found_option->set_value != NULL)
-        {
-            fprintf(stderr, "Option `%s` already seen previously.. ignoring option.\n",
-                option_get_name(found_option));
-            continue;
-        }
+    size_t index_capacity = notation_index_capacity(name_count);
+    command->option_index = calloc(index_capacity * NOTATION_INDEX_LANES, sizeof(uint32_t));
+    if (command->option_index == NULL)
+    {
+        diagnostics_push(&command->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
 
-        arguments_init(&found_option->parsed_arguments,
-                       command->parsed_arguments.argv_arguments[i],
-                       (int)command->parsed_arguments.argv_count - ((int)i + 1),
-                       command->parsed_arguments.argv_arguments + (i + 1));
+    PARSE_STATS_ALLOCATION(sizeof(uint32_t) * index_capacity * NOTATION_INDEX_LANES);
 
-        int consumed = option_parse(found_option);
-        if (consumed < 0)
-        {
-            fprintf(stderr, "Failed to parse flag `%s`: value invalid\n",
-                    command->parsed_arguments.argv_arguments[i]);
+    command->option_index_capacity = index_capacity;
+    for (size_t i = 0; i < command->option_count; ++i)
+        notation_index_insert(command->option_index, index_capacity,
+                              shared_value_read_const(&command->options[i].shared_notation), (uint32_t)(i + 1));
 
-            continue;
-        }
-        i += consumed;
+    if (!command_compile_constraints_(command))
+    {
+        diagnostics_push(&command->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
     }
 
+    command->is_frozen = true;
     return true;
 }
 
-bool command_is_option_present(const command_s* command, const char* option_flag)
+bool command_index_global_options(command_s* command, const command_s* globals)
 {
-    if (command == NULL)
+    if (command == NULL || globals == NULL || !command->is_frozen || globals->option_count == 0)
+        return false;
+
+    size_t name_count = command_count_option_names_(command) + command_count_option_names_(globals);
+
+    size_t index_capacity = notation_index_capacity(name_count);
+    uint32_t* option_index = calloc(index_capacity * NOTATION_INDEX_LANES, sizeof(uint32_t));
+    if (option_index == NULL)
         return false;
 
+    PARSE_STATS_ALLOCATION(sizeof(uint32_t) * index_capacity * NOTATION_INDEX_LANES);
+
+    // the options of the command go in first, so they come first in the probe sequence of a name they share with a global option
     for (size_t i = 0; i < command->option_count; ++i)
-        if (notation_has_value(shared_value_read_const(&command->options[i].shared_notation), option_flag))
-            return command->options[i].set_value != NULL;
+        notation_index_insert(option_index, index_capacity,
+                              shared_value_read_const(&command->options[i].shared_notation), (uint32_t)(i + 1));
+    for (size_t i = 0; i < globals->option_count; ++i)
+        notation_index_insert(option_index, index_capacity,
+                              shared_value_read_const(&globals->options[i].shared_notation), (uint32_t)(command->option_count + i + 1));
+
+    free(command->option_index);
+    command->option_index = option_index;
+    command->option_index_capacity = index_capacity;
+    command->is_globally_indexed = true;
+    return true;
+}
+
+bool command_parse(command_s* command)
+{
+    if (command == NULL)
+        return false;
+
+    PARSE_STATS_BEGIN(command->stats, PARSE_STATS_PHASE_COMMAND_PARSE);
+    bool result = command_parse_(command);
+    PARSE_STATS_END();
+    return result;
+}
+
+bool command_is_option_present(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    if (found_option == NULL)
+        return false;
+
+    const command_s* owner = command_option_owner_(command, found_option);
+    return bitset_test(owner->present_options, (size_t)(found_option - owner->options));
+}
+
+bool command_is_option_defaulted(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    if (found_option == NULL)
+        return false;
+
+    const command_s* owner = command_option_owner_(command, found_option);
+    return bitset_test(owner->defaulted_options, (size_t)(found_option - owner->options));
+}
+
+bool command_set_option_value(command_s* command, const char* option_flag, const void* value)
+{
+    option_s* found_option = command_find_option(command, option_flag);
+    if (found_option == NULL || !option_set_value(found_option, value))
+        return false;
+
+    const command_s* owner = command_option_owner_(command, found_option);
+    if (owner->option_word_count == 0)
+        return true;
 
-    return false;
+    size_t option_index = (size_t)(found_option - owner->options);
+    bitset_set(owner->present_options, option_index);
+    bitset_reset(owner->defaulted_options, option_index);
+    return true;
 }
 
 bool command_has_missing_required_options(const command_s* command)
@@ -174,11 +392,24 @@ bool command_has_missing_required_options(const command_s* command)
     if (command == NULL)
         return false;
 
-    for (size_t i = 0; i < command->option_count; ++i)
-        if (command->options[i].is_required && command->options[i].set_value == NULL)
-            return true;
+    return bitset_any_and_not(command->required_options, command->present_options, command->option_word_count);
+}
 
-    return false;
+size_t command_get_missing_required_option_indices(const command_s* command, size_t* index_buffer, size_t buffer_length)
+{
+    if (command == NULL || index_buffer == NULL || buffer_length == 0)
+        return 0;
+
+    return bitset_collect_and_not(command->required_options, command->present_options,
+                                  command->option_word_count, index_buffer, buffer_length);
+}
+
+const option_s* command_get_option(const command_s* command, size_t option_index)
+{
+    if (command == NULL || option_index >= command->option_count)
+        return NULL;
+
+    return &command->options[option_index];
 }
 
 
@@ -191,11 +422,18 @@ option_s* command_get_missing_required_options(const command_s* command, int* mi
     }
 
     option_s* ret_arr = malloc(sizeof(option_s) * command->option_count);
+    if (ret_arr == NULL)
+    {
+        *missing_count = 0;
+        return NULL;
+    }
+
+    PARSE_STATS_ALLOCATION(sizeof(option_s) * command->option_count);
     int missing_required_count = 0;
     
     for (size_t i = 0; i < command->option_count; ++i)
     {
-        if (!command->options[i].is_required || command->options[i].set_value != NULL)
+        if (!bitset_test(command->required_options, i) || bitset_test(command->present_options, i))
             continue;
 
         ret_arr[missing_required_count] = command->options[i];
@@ -220,7 +458,7 @@ command_get_missing_required_options_static(
     size_t missing_required_count = 0;
     for (size_t i = 0; i < command->option_count && missing_required_count < buffer_length; ++i)
     {
-        if (!command->options[i].is_required || command->options[i].set_value != NULL)
+        if (!bitset_test(command->required_options, i) || bitset_test(command->present_options, i))
             continue;
 
         missing_buffer[missing_required_count++] = command->options[i];
@@ -231,14 +469,11 @@ command_get_missing_required_options_static(
 
 option_s* command_find_option(const command_s* command, const char* option_flag)
 {
-    if (command == NULL || command->option_count == 0)
+    if (command == NULL || option_flag == NULL)
         return NULL;
 
-    for (size_t i = 0; i < command->option_count; ++i)
-        if (notation_has_value(shared_value_read_const(&command->options[i].shared_notation), option_flag))
-            return &command->options[i];
-
-    return NULL;
+    const command_s* globals = command_has_globals_(command) ? command->globals : NULL;
+    return command_find_option_(command, globals, option_flag, NULL);
 }
 
 bool command_is_of_flag(const command_s* command, const char* command_name)
@@ -264,12 +499,45 @@ const char* command_get_description(const command_s* command)
     return command->notation.description;
 }
 
+const positional_s* command_find_positional(const command_s* command, const char* name)
+{
+    if (command == NULL || name == NULL)
+        return NULL;
+
+    // commands hold a handful of positionals at most, so a linear search is all it takes
+    for (size_t i = 0; i < command->positional_count; ++i)
+        if (strcmp(command->positionals[i].name, name) == 0)
+            return &command->positionals[i];
+
+    return NULL;
+}
+
+const diagnostics_s* command_get_diagnostics(const command_s* command)
+{
+    if (command == NULL)
+        return NULL;
+
+    return &command->diagnostics;
+}
+
 const char** command_get_parameters(const command_s* command, int* parameter_count)
 {
     *parameter_count = (int)command->parsed_arguments.parameter_count;
     return command->parsed_arguments.parameters;
 }
 
+const char* const* command_get_passthrough(const command_s* command, size_t* passthrough_count)
+{
+    if (command == NULL)
+    {
+        *passthrough_count = 0;
+        return NULL;
+    }
+
+    *passthrough_count = command->passthrough_count;
+    return command->passthrough;
+}
+
 const void* command_read_option(const command_s* command, const char* option_flag)
 {
     const option_s* found_option = command_find_option(command, option_flag);
@@ -313,3 +581,587 @@ const char** command_read_multi_string_option(const command_s* command, const ch
     return option_read_multi_string(found_option, string_count);
 }
 
+
+const char** command_read_string_list_option(const command_s* command, const char* option_flag, size_t* string_count)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_string_list(found_option, string_count);
+}
+
+size_t command_read_count_option(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_count(found_option);
+}
+
+int command_read_choice_option(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_choice(found_option);
+}
+
+const char* command_read_choice_name_option(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_choice_name(found_option);
+}
+
+uint64_t command_read_size_option(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_size(found_option);
+}
+
+uint64_t command_read_duration_option(const command_s* command, const char* option_flag)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_duration(found_option);
+}
+
+const void* command_read_custom_option(const command_s* command, const char* option_flag, const option_type_vtable_s* custom_type)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_read_custom(found_option, custom_type);
+}
+
+size_t command_get_positional_count(const command_s* command, const char* name)
+{
+    return positional_get_count(command_find_positional(command, name));
+}
+
+int command_read_int_positional(const command_s* command, const char* name, size_t index)
+{
+    return positional_read_int(command_find_positional(command, name), index);
+}
+
+float command_read_float_positional(const command_s* command, const char* name, size_t index)
+{
+    return positional_read_float(command_find_positional(command, name), index);
+}
+
+const char* command_read_string_positional(const command_s* command, const char* name, size_t index)
+{
+    return positional_read_string(command_find_positional(command, name), index);
+}
+
+uint64_t command_read_size_positional(const command_s* command, const char* name, size_t index)
+{
+    return positional_read_size(command_find_positional(command, name), index);
+}
+
+uint64_t command_read_duration_positional(const command_s* command, const char* name, size_t index)
+{
+    return positional_read_duration(command_find_positional(command, name), index);
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+option_s* command_find_option_(const command_s* command, const command_s* globals, const char* option_flag, const command_s** owner)
+{
+    if (owner != NULL)
+        *owner = command;
+
+    if (command->option_count == 0 && globals == NULL)
+        return NULL;
+
+    PARSE_STATS_COUNT(PARSE_STATS_FLAG_LOOKUPS, 1);
+
+    // frozen commands probe their lookup-index instead of scanning every option,
+    // which in a frozen command-tree holds the global options as well, see `command_index_global_options()`
+    if (command->option_index != NULL)
+    {
+        size_t capacity = command->option_index_capacity;
+        const uint32_t* tags = command->option_index + capacity;
+        const uint32_t* lengths = command->option_index + capacity * 2;
+
+        size_t length = strlen(option_flag);
+        uint64_t hash = string_set_hash(option_flag, length);
+        uint32_t tag = notation_index_tag(hash);
+
+        size_t mask = capacity - 1;
+        for (size_t slot = (size_t)hash & mask;
+             command->option_index[slot] != 0;
+             slot = (slot + 1) & mask)
+        {
+            // only a slot with a matching tag and length touches the option and its notation
+            if (tags[slot] != tag || lengths[slot] != length)
+                continue;
+
+            // the entries past the options of the command belong to the global options
+            size_t entry = command->option_index[slot] - 1;
+            const command_s* entry_owner = command;
+            if (entry >= command->option_count)
+            {
+                if (globals == NULL || entry - command->option_count >= globals->option_count)
+                    continue;
+
+                entry_owner = globals;
+                entry -= command->option_count;
+            }
+
+            option_s* option = &entry_owner->options[entry];
+            if (notation_has_value(shared_value_read_const(&option->shared_notation), option_flag))
+            {
+                if (owner != NULL)
+                    *owner = entry_owner;
+                return option;
+            }
+        }
+
+        // an index made before the command joined a frozen command-tree only holds the options of the command
+        if (globals == NULL || command->is_globally_indexed)
+            return NULL;
+
+        return command_find_option_(globals, NULL, option_flag, owner);
+    }
+
+    // the options of the command shadow the global options of its tree
+    for (size_t i = 0; i < command->option_count; ++i)
+        if (notation_has_value(shared_value_read_const(&command->options[i].shared_notation), option_flag))
+            return &command->options[i];
+
+    if (globals == NULL)
+        return NULL;
+
+    return command_find_option_(globals, NULL, option_flag, owner);
+}
+
+const command_s* command_option_owner_(const command_s* command, const option_s* option)
+{
+    if (command_has_globals_(command) &&
+        option >= command->globals->options && option < command->globals->options + command->globals->option_count)
+        return command->globals;
+
+    return command;
+}
+
+bool command_has_globals_(const command_s* command)
+{
+    return command->globals != NULL && command->globals != command && command->globals->option_count > 0;
+}
+
+size_t command_count_option_names_(const command_s* command)
+{
+    size_t name_count = 0;
+    for (size_t i = 0; i < command->option_count; ++i)
+    {
+        const notation_s* notation = shared_value_read_const(&command->options[i].shared_notation);
+        name_count += notation != NULL ? notation->alias_count + 1 : 1;
+    }
+
+    return name_count;
+}
+
+size_t command_find_end_of_options_(const command_s* command)
+{
+    // the arguments before the marker are scanned by the parse anyway, the ones after it are never touched
+    for (size_t i = 0; i < command->parsed_arguments.argv_count; ++i)
+        if (strcmp(command->parsed_arguments.argv_arguments[i], COMMAND_END_OF_OPTIONS) == 0)
+            return i;
+
+    return command->parsed_arguments.argv_count;
+}
+
+void command_parse_positionals_(command_s* command, size_t candidate_count)
+{
+    if (command->positional_count == 0)
+        return;
+
+    const char* const* parameters = (const char* const*)command->parsed_arguments.parameters;
+    size_t parameter_count = candidate_count;
+
+    size_t reserved_count = 0;
+    for (size_t i = 0; i < command->positional_count; ++i)
+        reserved_count += command->positionals[i].min_count;
+
+    // every positional takes what it can, while leaving enough parameters for the minimum of the ones after it
+    size_t next_parameter = 0;
+    for (size_t i = 0; i < command->positional_count; ++i)
+    {
+        positional_s* positional = &command->positionals[i];
+        reserved_count -= positional->min_count;
+
+        size_t remaining_count = parameter_count - next_parameter;
+        size_t take_count = remaining_count > reserved_count ? remaining_count - reserved_count : 0;
+        if (take_count > positional->max_count)
+            take_count = positional->max_count;
+
+        if (take_count < positional->min_count)
+            diagnostics_push(&command->diagnostics, DIAGNOSTIC_MISSING_POSITIONAL, DIAGNOSTIC_NO_ARGV_INDEX, positional->name, positional->type);
+
+        size_t invalid_index = 0;
+        const char* const* taken = take_count > 0 ? parameters + next_parameter : NULL;
+        if (!positional_parse(positional, taken, take_count, &invalid_index))
+        {
+            if (invalid_index < take_count)
+                diagnostics_push(&command->diagnostics, DIAGNOSTIC_INVALID_VALUE,
+                                 command_argv_index_of_(command, taken[invalid_index]),
+                                 positional->name, positional->type);
+            else
+                diagnostics_push(&command->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        }
+
+        next_parameter += take_count;
+    }
+
+    if (next_parameter < parameter_count)
+        diagnostics_push(&command->diagnostics, DIAGNOSTIC_EXTRA_POSITIONAL,
+                         command_argv_index_of_(command, parameters[next_parameter]),
+                         parameters[next_parameter], MAX_OPTION_TYPE_COUNT);
+}
+
+void command_exclude_parameter_(command_s* command, size_t* excluded_count, const char* argument)
+{
+    // the candidates fill the buffer from the front, so the excluded arguments fill it from the back
+    (*excluded_count)++;
+    command->parsed_arguments.parameters[command->parsed_arguments.argv_count - *excluded_count] = argument;
+}
+
+void command_append_excluded_(command_s* command, size_t excluded_count)
+{
+    const char** parameters = command->parsed_arguments.parameters;
+    const char** excluded = parameters + command->parsed_arguments.argv_count - excluded_count;
+
+    // they were written back to front, so they're turned around first to end up in argv order
+    for (size_t i = 0; i < excluded_count / 2; ++i)
+    {
+        const char* argument = excluded[i];
+        excluded[i] = excluded[excluded_count - 1 - i];
+        excluded[excluded_count - 1 - i] = argument;
+    }
+
+    memmove(parameters + command->parsed_arguments.parameter_count, excluded, sizeof(char*) * excluded_count);
+    command->parsed_arguments.parameter_count += excluded_count;
+}
+
+bool command_add_constraint_(command_s* command, constraint_kind_e kind, const char* first_flag, size_t flag_n, va_list flags)
+{
+    if (command == NULL || command->is_frozen)
+        return false;
+
+    if (!dynamic_array_reserve((void**)&command->constraints, &command->constraint_capacity, sizeof(constraint_s), command->constraint_count + 1))
+        return false;
+
+    // the related flags are filled in when the constraint is violated, so they get room for every option
+    size_t option_count = flag_n + (first_flag != NULL ? 1 : 0);
+    size_t* option_indices = malloc((sizeof(size_t) + sizeof(char*)) * option_count);
+    if (option_indices == NULL)
+        return false;
+
+    PARSE_STATS_ALLOCATION((sizeof(size_t) + sizeof(char*)) * option_count);
+
+    // only the options of the command itself, so that every index fits in its bitsets
+    for (size_t i = 0; i < option_count; ++i)
+    {
+        const char* flag = first_flag != NULL && i == 0 ? first_flag : va_arg(flags, const char*);
+        const option_s* option = flag != NULL ? command_find_option_(command, NULL, flag, NULL) : NULL;
+        if (option == NULL)
+        {
+            free(option_indices);
+            return false;
+        }
+
+        option_indices[i] = (size_t)(option - command->options);
+    }
+
+    command->constraints[command->constraint_count++] = (constraint_s){
+        .kind = kind,
+        .option_count = option_count,
+        .option_indices = option_indices,
+        .mask = NULL,
+        .related_flags = (const char**)(option_indices + option_count)
+    };
+
+    command_drop_constraint_masks_(command);
+    return true;
+}
+
+bool command_compile_constraints_(command_s* command)
+{
+    if (command->constraint_count == 0 || command->option_word_count == 0 || command->constraint_masks != NULL)
+        return true;
+
+    size_t word_count = command->option_word_count;
+    command->constraint_masks = calloc(word_count * command->constraint_count, sizeof(uint64_t));
+    if (command->constraint_masks == NULL)
+        return false;
+
+    PARSE_STATS_ALLOCATION(sizeof(uint64_t) * word_count * command->constraint_count);
+
+    for (size_t i = 0; i < command->constraint_count; ++i)
+    {
+        constraint_s* constraint = &command->constraints[i];
+        constraint->mask = command->constraint_masks + word_count * i;
+
+        size_t first = constraint->kind == CONSTRAINT_REQUIRES ? 1 : 0;
+        for (size_t j = first; j < constraint->option_count; ++j)
+            bitset_set(constraint->mask, constraint->option_indices[j]);
+    }
+
+    return true;
+}
+
+void command_drop_constraint_masks_(command_s* command)
+{
+    // the masks are as wide as the option bitsets and there's one per constraint, so they're compiled again on the next parse
+    free(command->constraint_masks);
+    command->constraint_masks = NULL;
+    for (size_t i = 0; i < command->constraint_count; ++i)
+        command->constraints[i].mask = NULL;
+}
+
+void command_check_constraints_(const command_s* owner, command_s* command)
+{
+    const uint64_t* present = owner->present_options;
+    size_t word_count = owner->option_word_count;
+
+    for (size_t i = 0; i < owner->constraint_count; ++i)
+    {
+        constraint_s* constraint = &owner->constraints[i];
+        diagnostic_code_e code = MAX_DIAGNOSTIC_CODE_COUNT;
+        const char* flag = NULL;
+        bool list_present = false;
+        bool list_missing = false;
+
+        switch (constraint->kind)
+        {
+        case CONSTRAINT_EXCLUSIVE:
+            if (bitset_count_and(present, constraint->mask, word_count) <= 1)
+                continue;
+
+            code = DIAGNOSTIC_EXCLUSIVE_OPTIONS;
+            list_present = true;
+            break;
+
+        case CONSTRAINT_REQUIRES:
+            if (!bitset_test(present, constraint->option_indices[0]) || !bitset_any_and_not(constraint->mask, present, word_count))
+                continue;
+
+            code = DIAGNOSTIC_MISSING_DEPENDENCY;
+            flag = option_get_name(&owner->options[constraint->option_indices[0]]);
+            list_missing = true;
+            break;
+
+        case CONSTRAINT_AT_LEAST_ONE:
+            if (bitset_count_and(present, constraint->mask, word_count) > 0)
+                continue;
+
+            code = DIAGNOSTIC_MISSING_ONE_OF;
+            break;
+
+        default:
+            continue;
+        }
+
+        // only a violation walks the options of the constraint, to name the ones involved
+        size_t related_count = 0;
+        size_t first = constraint->kind == CONSTRAINT_REQUIRES ? 1 : 0;
+        for (size_t j = first; j < constraint->option_count; ++j)
+        {
+            size_t option_index = constraint->option_indices[j];
+            bool is_present = bitset_test(present, option_index);
+            if ((list_present && !is_present) || (list_missing && is_present))
+                continue;
+
+            constraint->related_flags[related_count++] = option_get_name(&owner->options[option_index]);
+        }
+
+        diagnostics_push_constraint(&command->diagnostics, code, flag, constraint->related_flags, related_count);
+    }
+}
+
+size_t command_argv_index_of_(const command_s* command, const char* argument)
+{
+    // parameters point into argv, so only a diagnostic pays for finding back where one came from
+    for (size_t i = 0; i < command->parsed_arguments.argv_count; ++i)
+        if (command->parsed_arguments.argv_arguments[i] == argument)
+            return i;
+
+    return DIAGNOSTIC_NO_ARGV_INDEX;
+}
+
+bool command_grow_option_bits_(command_s* command, size_t word_count)
+{
+    // required, present and defaulted share one allocation
+    uint64_t* bits = calloc(word_count * 3, sizeof(uint64_t));
+    if (bits == NULL)
+        return false;
+
+    PARSE_STATS_ALLOCATION(sizeof(uint64_t) * word_count * 3);
+
+    command_drop_constraint_masks_(command);
+    if (command->required_options != NULL)
+    {
+        memcpy(bits, command->required_options, sizeof(uint64_t) * command->option_word_count);
+        memcpy(bits + word_count, command->present_options, sizeof(uint64_t) * command->option_word_count);
+        memcpy(bits + word_count * 2, command->defaulted_options, sizeof(uint64_t) * command->option_word_count);
+        free(command->required_options);
+    }
+
+    command->option_word_count = word_count;
+    command->required_options = bits;
+    command->present_options = bits + word_count;
+    command->defaulted_options = bits + word_count * 2;
+    return true;
+}
+
+void command_finish_parse_(command_s* command)
+{
+    if (command->option_word_count == 0)
+        return;
+
+    bitset_complement(command->defaulted_options, command->present_options, command->option_count);
+}
+
+bool command_parse_(command_s* command)
+{
+    // a command can be parsed again, so nothing of a previous parse may carry over
+    for (size_t i = 0; i < command->option_count; ++i)
+        option_reset(&command->options[i]);
+
+    bitset_clear(command->present_options, command->option_word_count);
+    diagnostics_clear(&command->diagnostics);
+    command->passthrough = NULL;
+    command->passthrough_count = 0;
+    for (size_t i = 0; i < command->positional_count; ++i)
+        positional_reset(&command->positionals[i]);
+
+    // only the called command gets parsed, so the global options hold the values of this parse alone
+    bool has_globals = command_has_globals_(command);
+
+    // a command that was never frozen compiles its constraints here, so they're checked either way
+    if (!command_compile_constraints_(command) || (has_globals && !command_compile_constraints_(command->globals)))
+    {
+        diagnostics_push(&command->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    if (has_globals)
+    {
+        for (size_t i = 0; i < command->globals->option_count; ++i)
+            option_reset(&command->globals->options[i]);
+
+        bitset_clear(command->globals->present_options, command->globals->option_word_count);
+    }
+
+    if (command->parsed_arguments.argv_count == 0)
+    {
+        command_parse_positionals_(command, 0);
+        command_finish_parse_(command);
+        command_check_constraints_(command, command);
+        if (has_globals)
+        {
+            command_finish_parse_(command->globals);
+            command_check_constraints_(command->globals, command);
+        }
+        return true;
+    }
+
+    if (!arguments_prepare_parameters(&command->parsed_arguments))
+    {
+        diagnostics_push(&command->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    // options only see the arguments in front of `--`, so none of them can consume the marker or what follows
+    size_t option_argument_count = command_find_end_of_options_(command);
+    if (option_argument_count < command->parsed_arguments.argv_count)
+    {
+        command->passthrough = command->parsed_arguments.argv_arguments + option_argument_count + 1;
+        command->passthrough_count = command->parsed_arguments.argv_count - option_argument_count - 1;
+    }
+
+
+    // without options or positionals every argument is a plain parameter, flag-shaped or not
+    if (command->option_count == 0 && !has_globals && command->positional_count == 0)
+    {
+        for (size_t i = 0; i < option_argument_count; ++i)
+            command->parsed_arguments.parameters[i] = command->parsed_arguments.argv_arguments[i];
+
+        command->parsed_arguments.parameter_count = option_argument_count;
+        return true;
+    }
+
+    // unknown flags and values an option rejected are kept as parameters, but never handed to a positional
+    size_t excluded_count = 0;
+
+    for (int64_t i = 0; i < (int64_t)option_argument_count; ++i)
+    {
+        PARSE_STATS_COUNT(PARSE_STATS_ARGS_SCANNED, 1);
+        bool arg_is_flag = notation_is_valid_flag(command->parsed_arguments.argv_arguments[i]);
+        // when argument is not a flag
+        if (!arg_is_flag)
+        {
+            command->parsed_arguments.parameters[command->parsed_arguments.parameter_count] =
+                command->parsed_arguments.argv_arguments[i];
+
+            command->parsed_arguments.parameter_count++;
+            continue;
+        }
+
+        // when the argument is a flag, but not used by any options within this command
+        const command_s* owner = NULL;
+        option_s* found_option = command_find_option_(command, has_globals ? command->globals : NULL,
+                                                      command->parsed_arguments.argv_arguments[i], &owner);
+        if (found_option == NULL)
+        {
+            diagnostics_push(&command->diagnostics, DIAGNOSTIC_UNKNOWN_OPTION, (size_t)i,
+                             command->parsed_arguments.argv_arguments[i], MAX_OPTION_TYPE_COUNT);
+            command_exclude_parameter_(command, &excluded_count, command->parsed_arguments.argv_arguments[i]);
+            continue;
+        }
+
+        if (found_option->set_value != NULL && found_option->repeat_policy == OPTION_REPEAT_FIRST_WINS)
+        {
+            diagnostics_push(&command->diagnostics, DIAGNOSTIC_REPEATED_OPTION, (size_t)i,
+                             command->parsed_arguments.argv_arguments[i], found_option->type);
+            found_option->occurrence_count++;
+
+            // the ignored occurrence still takes its values, otherwise they'd end up as parameters
+            i += (int64_t)option_count_values(found_option, option_argument_count - ((size_t)i + 1),
+                                              command->parsed_arguments.argv_arguments + (i + 1));
+            continue;
+        }
+
+        // a repeated option only keeps the arguments of its latest occurrence
+        arguments_clean(&found_option->parsed_arguments);
+        arguments_init(&found_option->parsed_arguments,
+                       command->parsed_arguments.argv_arguments[i],
+                       (int)option_argument_count - ((int)i + 1),
+                       command->parsed_arguments.argv_arguments + (i + 1));
+
+        int consumed = option_parse(found_option);
+        if (consumed < 0)
+        {
+            diagnostics_push_invalid_value(&command->diagnostics, (size_t)i,
+                                           command->parsed_arguments.argv_arguments[i], found_option);
+
+            // the value the option couldn't take was still meant for it, not for a positional
+            if (found_option->type != OPTION_TYPE_BOOL && i + 1 < (int64_t)option_argument_count &&
+                !notation_is_valid_flag(command->parsed_arguments.argv_arguments[i + 1]))
+            {
+                command_exclude_parameter_(command, &excluded_count, command->parsed_arguments.argv_arguments[i + 1]);
+                i++;
+            }
+            continue;
+        }
+
+        if (found_option->set_value != NULL)
+            bitset_set(owner->present_options, (size_t)(found_option - owner->options));
+
+        i += consumed;
+    }
+
+    command_parse_positionals_(command, command->parsed_arguments.parameter_count);
+    command_append_excluded_(command, excluded_count);
+    command_finish_parse_(command);
+    command_check_constraints_(command, command);
+    if (has_globals)
+    {
+        command_finish_parse_(command->globals);
+        command_check_constraints_(command->globals, command);
+    }
+    return true;
+}
+
+// END LOCAL IMPLEMENTATIONS //
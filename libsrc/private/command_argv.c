@@ -0,0 +1,218 @@
+#include "command_argv.h"
+
+#include "option.h"
+#include "command.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+// LOCAL DEFINITIONS //
+
+// big enough for any formatted int, float or 64-bit value with its suffix
+#define COMMAND_ARGV_NUMBER_LENGTH 32
+
+typedef struct command_argv_writer_
+{
+    char** argv; /**< _NULL_ on the first pass, which only counts. */
+    char* text;
+    size_t count;
+    size_t text_size;
+} command_argv_writer_s;
+
+static void command_argv_reference_(command_argv_writer_s* writer, const char* argument);
+static void command_argv_copy_(command_argv_writer_s* writer, const char* text);
+static void command_argv_options_(command_argv_writer_s* writer, const command_s* command, argv_names_e names);
+static void command_argv_option_(command_argv_writer_s* writer, const option_s* option, argv_names_e names);
+static void command_argv_number_(const option_s* option, char* text);
+static void command_argv_write_(command_argv_writer_s* writer, const command_s* command, const char* program, argv_names_e names);
+
+// END LOCAL DEFINITIONS //
+
+size_t command_write_argv(const command_s* command, const char* program, argv_names_e names, void* buffer, size_t buffer_length, size_t* argc)
+{
+    if (command == NULL || (size_t)names >= MAX_ARGV_NAMES_COUNT)
+        return 0;
+
+    // first pass: count the elements and the formatted text
+    command_argv_writer_s writer = {0};
+    command_argv_write_(&writer, command, program, names);
+
+    if (argc != NULL)
+        *argc = writer.count;
+
+    size_t array_size = sizeof(char*) * (writer.count + 1);
+    size_t total_size = array_size + writer.text_size;
+    if (buffer == NULL || buffer_length < total_size)
+        return total_size;
+
+    // second pass: fill in the array, with the formatted text right behind it
+    writer = (command_argv_writer_s){
+        .argv = buffer,
+        .text = (char*)buffer + array_size,
+    };
+    command_argv_write_(&writer, command, program, names);
+    writer.argv[writer.count] = NULL;
+
+    return total_size;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+void command_argv_reference_(command_argv_writer_s* writer, const char* argument)
+{
+    if (writer->argv != NULL)
+        writer->argv[writer->count] = (char*)argument;
+
+    writer->count++;
+}
+
+void command_argv_copy_(command_argv_writer_s* writer, const char* text)
+{
+    size_t length = strlen(text) + 1;
+    if (writer->argv != NULL)
+    {
+        memcpy(writer->text, text, length);
+        writer->argv[writer->count] = writer->text;
+        writer->text += length;
+    }
+
+    writer->count++;
+    writer->text_size += length;
+}
+
+void command_argv_options_(command_argv_writer_s* writer, const command_s* command, argv_names_e names)
+{
+    for (size_t i = 0; i < command->option_count; ++i)
+        command_argv_option_(writer, &command->options[i], names);
+}
+
+void command_argv_option_(command_argv_writer_s* writer, const option_s* option, argv_names_e names)
+{
+    if (option->set_value == NULL)
+        return;
+
+    const char* name = option_get_name(option);
+    if (names == ARGV_NAMES_AS_PASSED && option->parsed_arguments.self != NULL)
+        name = option->parsed_arguments.self;
+
+    const char* const* values = option->set_value;
+    switch (option->type)
+    {
+    case OPTION_TYPE_BOOL:
+    {
+        // an option that was set to false is left out, as the absence of the flag reads false
+        if (!*(const bool*)option->set_value)
+            break;
+
+        size_t occurrences = option->repeat_policy == OPTION_REPEAT_COUNT && option->occurrence_count > 1 ? option->occurrence_count : 1;
+        for (size_t i = 0; i < occurrences; ++i)
+            command_argv_reference_(writer, name);
+        break;
+    }
+
+    case OPTION_TYPE_STRING:
+        // every accumulated value needs its own occurrence, otherwise only the latest value counts
+        if (option->repeat_policy == OPTION_REPEAT_ACCUMULATE)
+        {
+            for (size_t i = 0; i < option->value_count; ++i)
+            {
+                command_argv_reference_(writer, name);
+                command_argv_reference_(writer, values[i]);
+            }
+        }
+        else if (option->value_count > 0)
+        {
+            command_argv_reference_(writer, name);
+            command_argv_reference_(writer, values[option->value_count - 1]);
+        }
+        break;
+
+    case OPTION_TYPE_MULTI_STRING:
+        command_argv_reference_(writer, name);
+        for (size_t i = 0; i < option->value_count; ++i)
+            command_argv_reference_(writer, values[i]);
+        break;
+
+    case OPTION_TYPE_CHOICE:
+        command_argv_reference_(writer, name);
+        command_argv_reference_(writer, option_read_choice_name(option));
+        break;
+
+    case OPTION_TYPE_CUSTOM:
+        // the value of a custom type can't be formatted, so it's only ever the text it was parsed from
+        if (option->parsed_arguments.parameter_count == 0)
+            break;
+
+        command_argv_reference_(writer, name);
+        command_argv_reference_(writer, option->parsed_arguments.parameters[0]);
+        break;
+
+    default:
+        command_argv_reference_(writer, name);
+
+        // a number that wasn't changed is passed on as it was written, which also keeps its suffix
+        if (!option->is_overridden)
+        {
+            if (option->parsed_arguments.parameter_count > 0)
+                command_argv_reference_(writer, option->parsed_arguments.parameters[0]);
+            break;
+        }
+
+        char text[COMMAND_ARGV_NUMBER_LENGTH];
+        command_argv_number_(option, text);
+        command_argv_copy_(writer, text);
+        break;
+    }
+}
+
+void command_argv_number_(const option_s* option, char* text)
+{
+    switch (option->type)
+    {
+    case OPTION_TYPE_INT:
+        snprintf(text, COMMAND_ARGV_NUMBER_LENGTH, "%d", *(const int*)option->set_value);
+        break;
+    case OPTION_TYPE_FLOAT:
+        // 9 significant digits survive the round-trip of any float
+        snprintf(text, COMMAND_ARGV_NUMBER_LENGTH, "%.9g", (double)*(const float*)option->set_value);
+        break;
+    case OPTION_TYPE_SIZE:
+        snprintf(text, COMMAND_ARGV_NUMBER_LENGTH, "%" PRIu64, *(const uint64_t*)option->set_value);
+        break;
+    case OPTION_TYPE_DURATION:
+        snprintf(text, COMMAND_ARGV_NUMBER_LENGTH, "%" PRIu64 "ns", *(const uint64_t*)option->set_value);
+        break;
+    default:
+        text[0] = '\0';
+        break;
+    }
+}
+
+void command_argv_write_(command_argv_writer_s* writer, const command_s* command, const char* program, argv_names_e names)
+{
+    if (program != NULL)
+        command_argv_reference_(writer, program);
+
+    const char* command_name = command_get_name(command);
+    if (names == ARGV_NAMES_AS_PASSED && command->parsed_arguments.self != NULL)
+        command_name = command->parsed_arguments.self;
+    if (command_name != NULL)
+        command_argv_reference_(writer, command_name);
+
+    for (size_t i = 0; i < command->parsed_arguments.parameter_count; ++i)
+        command_argv_reference_(writer, command->parsed_arguments.parameters[i]);
+
+    command_argv_options_(writer, command, names);
+    if (command->globals != NULL && command->globals != command)
+        command_argv_options_(writer, command->globals, names);
+
+    if (command->passthrough == NULL)
+        return;
+
+    command_argv_reference_(writer, COMMAND_END_OF_OPTIONS);
+    for (size_t i = 0; i < command->passthrough_count; ++i)
+        command_argv_reference_(writer, command->passthrough[i]);
+}
+
+// END LOCAL IMPLEMENTATIONS //
@@ -3,22 +3,50 @@
 #include "command.h"
 #include "notation.h"
 #include "arguments.h"
+#include "option.h"
+#include "diagnostics.h"
+#include "schema_image.h"
+#include "parse_stats.h"
+#include "extra/dynamic_array.h"
+#include "extra/line_tokenizer.h"
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+
+// LOCAL DEFINITIONS //
+
+static bool command_tree_compact_(command_tree_s* tree);
+static bool command_tree_intern_strings_(command_tree_s* tree);
+static notation_s* command_tree_poolable_notation_(option_s* option);
+static size_t command_tree_find_index_(const command_tree_s* tree, const char* command_flag);
+static void command_tree_clean_image_(command_tree_s* tree);
+static bool command_tree_init_(command_tree_s* tree, size_t command_capacity);
+static void command_tree_clean_(command_tree_s* tree);
+static bool command_tree_freeze_(command_tree_s* tree);
+static bool command_tree_parse_base_(command_tree_s* tree, int argc, const char** argv);
+static bool command_tree_tokenize_line_(command_tree_s* tree, char* line, size_t length, int* argc);
+
+// END LOCAL DEFINITIONS //
 
 bool command_tree_init(command_tree_s* tree, size_t command_capacity)
 {
-    if (tree == NULL || command_capacity == 0)
+    if (tree == NULL)
         return false;
 
-    tree->description = NULL;
-    tree->commands = malloc(sizeof(command_s) * command_capacity);
-    if (tree->commands == NULL)
+    tree->stats = (parse_stats_s){0};
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CONSTRUCTION);
+    bool result = command_tree_init_(tree, command_capacity);
+    PARSE_STATS_END();
+    return result;
+}
+
+bool command_tree_init_borrowed(command_tree_s* tree, size_t command_capacity)
+{
+    if (!command_tree_init(tree, command_capacity))
         return false;
 
-    tree->command_capacity = command_capacity;
-    tree->command_count = 0;
+    tree->is_borrowed = true;
     return true;
 }
 
@@ -27,49 +55,81 @@ bool command_tree_set_description(command_tree_s* tree, const char* description)
     if (tree == NULL || description == NULL)
         return false;
 
+    if (tree->is_borrowed)
+    {
+        tree->description = (char*)description;
+        return true;
+    }
+
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CONSTRUCTION);
     tree->description = strdup(description);
+    if (tree->description != NULL)
+        PARSE_STATS_ALLOCATION(strlen(description) + 1);
+    PARSE_STATS_END();
     return tree->description != NULL;
 }
 
 void command_tree_clean(command_tree_s* tree)
 {
-    if (tree == NULL || tree->command_capacity == 0)
+    if (tree == NULL)
         return;
 
-    for (size_t i = 0; i < tree->command_count; ++i)
-        command_clean(&tree->commands[i]);
-    
-    free(tree->description);
-    tree->description = NULL;
-    free(tree->commands);
-    tree->commands = NULL;
-
-    arguments_clean(&tree->parsed_arguments);
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CLEAN);
+    command_tree_clean_(tree);
+    PARSE_STATS_END();
 }
 
 bool command_tree_add_command(command_tree_s* tree, command_s* command)
 {
-    if (tree == NULL)
+    if (tree == NULL || tree->is_frozen)
         return false;
 
-    if (tree->command_count >= tree->command_capacity)
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CONSTRUCTION);
+    bool result = dynamic_array_reserve((void**)&tree->commands, &tree->command_capacity, sizeof(command_s), tree->command_count + 1);
+    PARSE_STATS_END();
+    if (!result)
         return false;
 
     memcpy(&tree->commands[tree->command_count], command, sizeof(command_s));
+    tree->commands[tree->command_count].stats = NULL;
+    tree->commands[tree->command_count].globals = NULL;
     tree->command_count++;
     return true;
 }
 
+bool command_tree_add_global_option(command_tree_s* tree, option_s* option)
+{
+    // a global option is parsed by whichever command is called, so there's no command to report it missing for
+    if (tree == NULL || option == NULL || tree->is_frozen || option->is_required)
+        return false;
+
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CONSTRUCTION);
+    bool result = command_add_option(&tree->globals, option);
+    PARSE_STATS_END();
+    return result;
+}
+
+bool command_tree_freeze(command_tree_s* tree)
+{
+    if (tree == NULL)
+        return false;
+
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CONSTRUCTION);
+    bool result = command_tree_freeze_(tree);
+    PARSE_STATS_END();
+    return result;
+}
+
 const command_s* command_tree_get_command(const command_tree_s* tree, const char* command_flag)
 {
     if (tree == NULL || command_flag == NULL)
         return NULL;
 
-    for (size_t i = 0; i < tree->command_count; ++i)
-        if (command_is_of_flag(&tree->commands[i], command_flag))
-            return &tree->commands[i];
+    size_t command_index = command_tree_find_index_(tree, command_flag);
+    if (command_index >= tree->command_count)
+        return NULL;
 
-    return NULL;
+    return &tree->commands[command_index];
 }
 
 bool command_tree_has_command(const command_tree_s* tree, const char* command_flag)
@@ -82,9 +142,238 @@ bool command_tree_parse_base(command_tree_s* tree, int argc, const char** argv)
     if (tree == NULL)
         return false;
 
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_PARSE_BASE);
+    bool result = command_tree_parse_base_(tree, argc, argv);
+    PARSE_STATS_END();
+    return result;
+}
+
+bool command_tree_parse_line(command_tree_s* tree, char* line, size_t length)
+{
+    if (tree == NULL || line == NULL)
+        return false;
+
+    // the tokens take the place of argv, which keeps pointing into the line after parsing
+    int argc = 0;
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_PARSE_BASE);
+    bool is_tokenized = command_tree_tokenize_line_(tree, line, length, &argc);
+    PARSE_STATS_END();
+
+    if (!is_tokenized || !command_tree_parse_base(tree, argc, tree->line_tokens))
+        return false;
+
+    return command_parse(&tree->commands[tree->called_command_index]);
+}
+
+command_s* command_tree_get_called_command(command_tree_s* tree)
+{
+    if (tree == NULL || tree->commands == NULL || tree->called_command_index >= tree->command_count)
+        return NULL;
+
+    command_s* called_command = &tree->commands[tree->called_command_index];
+    if (!called_command->is_set)
+        return NULL;
+
+    // the tree may have moved since its base was parsed
+    called_command->stats = &tree->stats;
+    called_command->globals = &tree->globals;
+    return called_command;
+}
+
+int command_tree_run(command_tree_s* tree, int argc, const char** argv)
+{
+    if (!command_tree_parse_base(tree, argc, argv))
+        return COMMAND_TREE_RUN_FAILURE;
+
+    command_s* called_command = &tree->commands[tree->called_command_index];
+    // the diagnostics stay with the called command, so the handler only ever sees a command that parsed cleanly
+    if (!command_parse(called_command) || diagnostics_has_errors(&called_command->diagnostics))
+        return COMMAND_TREE_RUN_FAILURE;
+
+    if (called_command->handler == NULL)
+    {
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_MISSING_HANDLER, 0,
+                         called_command->parsed_arguments.self, MAX_OPTION_TYPE_COUNT);
+        return COMMAND_TREE_RUN_FAILURE;
+    }
+
+    return called_command->handler(tree, called_command, called_command->handler_context);
+}
+
+const diagnostics_s* command_tree_get_diagnostics(const command_tree_s* tree)
+{
+    if (tree == NULL)
+        return NULL;
+
+    return &tree->diagnostics;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+bool command_tree_init_(command_tree_s* tree, size_t command_capacity)
+{
+    tree->description = NULL;
+    tree->diagnostics = (diagnostics_s){0};
+    tree->parsed_arguments = (arguments_s){0};
+    tree->called_command_index = 0;
+    tree->command_index_capacity = 0;
+    tree->command_index = NULL;
+    tree->image = NULL;
+    tree->image_length = 0;
+    tree->image_is_mapped = false;
+    tree->string_pool = NULL;
+    tree->string_pool_size = 0;
+    tree->line_tokens = NULL;
+    tree->line_token_capacity = 0;
+    tree->commands = NULL;
+    tree->command_block_size = 0;
+    tree->is_borrowed = false;
+    tree->command_capacity = 0;
+    if (!command_init(&tree->globals, 0))
+        return false;
+
+    if (!dynamic_array_reserve((void**)&tree->commands, &tree->command_capacity, sizeof(command_s), command_capacity))
+        return false;
+
+    tree->is_frozen = false;
+    tree->command_count = 0;
+    return true;
+}
+
+void command_tree_clean_(command_tree_s* tree)
+{
+    if (tree->image != NULL)
+    {
+        command_tree_clean_image_(tree);
+        return;
+    }
+
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        // the options and option bitsets of a frozen tree live in the same block as the commands
+        if (tree->commands[i].is_compacted)
+        {
+            for (size_t j = 0; j < tree->commands[i].option_count; ++j)
+                option_clean(&tree->commands[i].options[j]);
+
+            tree->commands[i].options = NULL;
+            tree->commands[i].option_count = 0;
+            tree->commands[i].required_options = NULL;
+        }
+
+        command_clean(&tree->commands[i]);
+    }
+
+    command_clean(&tree->globals);
+    if (!tree->is_borrowed)
+        free(tree->description);
+    tree->description = NULL;
+    free(tree->string_pool);
+    tree->string_pool = NULL;
+    tree->string_pool_size = 0;
+    free(tree->line_tokens);
+    tree->line_tokens = NULL;
+    tree->line_token_capacity = 0;
+    free(tree->command_index);
+    tree->command_index = NULL;
+    tree->command_index_capacity = 0;
+    free(tree->commands);
+    tree->commands = NULL;
+    tree->command_block_size = 0;
+    tree->command_count = 0;
+    tree->command_capacity = 0;
+    tree->is_frozen = false;
+
+    arguments_clean(&tree->parsed_arguments);
+    diagnostics_clean(&tree->diagnostics);
+}
+
+
+bool command_tree_freeze_(command_tree_s* tree)
+{
+    if (tree->is_frozen)
+        return true;
+
+    size_t name_count = 0;
+    for (size_t i = 0; i < tree->command_count; ++i)
+        name_count += tree->commands[i].notation.alias_count + 1;
+
+    diagnostics_clear(&tree->diagnostics);
+
+    string_set_s command_names = {0};
+    if (!string_set_init(&command_names, name_count))
+    {
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    // keep going after the first conflict so every conflict gets reported
+    bool is_valid = true;
+    if (!command_freeze(&tree->globals))
+    {
+        diagnostics_append(&tree->diagnostics, &tree->globals.diagnostics);
+        is_valid = false;
+    }
+
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        if (!notation_register_names(&tree->commands[i].notation, &command_names, &tree->diagnostics))
+            is_valid = false;
+
+        // the tree collects the problems of all its commands
+        if (!command_freeze(&tree->commands[i]))
+        {
+            diagnostics_append(&tree->diagnostics, &tree->commands[i].diagnostics);
+            is_valid = false;
+        }
+        else if (tree->globals.option_count > 0 && !command_index_global_options(&tree->commands[i], &tree->globals))
+        {
+            diagnostics_push(&tree->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+            is_valid = false;
+        }
+    }
+
+    string_set_clean(&command_names);
+    if (!is_valid)
+        return false;
+
+    size_t index_capacity = notation_index_capacity(name_count);
+    uint32_t* command_index = calloc(index_capacity * NOTATION_INDEX_LANES, sizeof(uint32_t));
+    if (command_index != NULL)
+        PARSE_STATS_ALLOCATION(sizeof(uint32_t) * index_capacity * NOTATION_INDEX_LANES);
+    if (command_index == NULL || !command_tree_intern_strings_(tree) || !command_tree_compact_(tree))
+    {
+        free(command_index);
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    for (size_t i = 0; i < tree->command_count; ++i)
+        notation_index_insert(command_index, index_capacity, &tree->commands[i].notation, (uint32_t)(i + 1));
+
+    tree->command_index = command_index;
+    tree->command_index_capacity = index_capacity;
+
+    tree->is_frozen = true;
+    return true;
+}
+
+
+bool command_tree_parse_base_(command_tree_s* tree, int argc, const char** argv)
+{
+    diagnostics_clear(&tree->diagnostics);
+
     if (argc <= 1)
+    {
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_MISSING_COMMAND, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
         return false;
+    }
 
+    // forget the command of a previous parse
+    if (tree->called_command_index < tree->command_count)
+        tree->commands[tree->called_command_index].is_set = false;
+
+    arguments_clean(&tree->parsed_arguments);
     arguments_init(&tree->parsed_arguments, *argv, argc-1, argv+1);
 
     // skip the calling path that's normally at argv[0]
@@ -92,37 +381,249 @@ bool command_tree_parse_base(command_tree_s* tree, int argc, const char** argv)
     argv++;
 
     const char* searching_flag_name = *argv;
+    PARSE_STATS_COUNT(PARSE_STATS_ARGS_SCANNED, 1);
     if (!notation_is_valid_flag(searching_flag_name))
+    {
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_UNKNOWN_COMMAND, 0, searching_flag_name, MAX_OPTION_TYPE_COUNT);
         return false;
+    }
 
     bool found_target = false;
 
+    size_t i = command_tree_find_index_(tree, searching_flag_name);
+    if (i < tree->command_count)
+    {
+        found_target = true;
+        tree->called_command_index = i;
+        tree->commands[i].is_set = true;
+
+        // bound on every parse rather than when the command is added, as the tree can be moved or returned by value in between
+        tree->commands[i].stats = &tree->stats;
+        tree->commands[i].globals = &tree->globals;
+        arguments_clean(&tree->commands[i].parsed_arguments);
+        arguments_init(&tree->commands[i].parsed_arguments, searching_flag_name, argc-1, argv+1);
+    }
+
+    if (!found_target)
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_UNKNOWN_COMMAND, 0, searching_flag_name, MAX_OPTION_TYPE_COUNT);
+
+    return found_target;
+}
+
+
+bool command_tree_tokenize_line_(command_tree_s* tree, char* line, size_t length, int* argc)
+{
+    diagnostics_clear(&tree->diagnostics);
+
+    // the first slot stands in for the calling path at argv[0], which a line doesn't have
+    size_t capacity = line_tokenizer_capacity(length) + 1;
+    if (capacity > INT_MAX ||
+        !dynamic_array_reserve((void**)&tree->line_tokens, &tree->line_token_capacity, sizeof(char*), capacity))
+    {
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    tree->line_tokens[0] = "";
+    size_t token_count = line_tokenize(line, length, tree->line_tokens + 1, tree->line_token_capacity - 1);
+    if (token_count == LINE_TOKENIZE_ERROR)
+    {
+        diagnostics_push(&tree->diagnostics, DIAGNOSTIC_INVALID_LINE, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    *argc = (int)token_count + 1;
+    return true;
+}
+
+size_t command_tree_find_index_(const command_tree_s* tree, const char* command_flag)
+{
+    PARSE_STATS_COUNT(PARSE_STATS_FLAG_LOOKUPS, 1);
+
+    // frozen trees probe their lookup-index instead of scanning every command
+    if (tree->command_index != NULL)
+    {
+        size_t capacity = tree->command_index_capacity;
+        const uint32_t* tags = tree->command_index + capacity;
+        const uint32_t* lengths = tree->command_index + capacity * 2;
+
+        size_t length = strlen(command_flag);
+        uint64_t hash = string_set_hash(command_flag, length);
+        uint32_t tag = notation_index_tag(hash);
+
+        size_t mask = capacity - 1;
+        for (size_t slot = (size_t)hash & mask;
+             tree->command_index[slot] != 0;
+             slot = (slot + 1) & mask)
+        {
+            if (tags[slot] != tag || lengths[slot] != length)
+                continue;
+
+            size_t command_index = tree->command_index[slot] - 1;
+            if (command_is_of_flag(&tree->commands[command_index], command_flag))
+                return command_index;
+        }
+
+        return tree->command_count;
+    }
+
+    for (size_t i = 0; i < tree->command_count; ++i)
+        if (command_is_of_flag(&tree->commands[i], command_flag))
+            return i;
+
+    return tree->command_count;
+}
+
+bool command_tree_compact_(command_tree_s* tree)
+{
+    if (tree->command_count == 0)
+        return dynamic_array_shrink((void**)&tree->commands, &tree->command_capacity, sizeof(command_s), 0);
+
+    size_t option_total = 0;
+    size_t word_total = 0;
     for (size_t i = 0; i < tree->command_count; ++i)
     {
-        notation_s* target_notation = &tree->commands[i].notation;
-        bool is_target_set = notation_has_value(target_notation, searching_flag_name);
+        option_total += tree->commands[i].option_count;
+        word_total += tree->commands[i].option_word_count * 3;
+    }
 
-        if (!is_target_set)
+    // the options follow the commands directly, aligned for the option structure
+    size_t options_offset = sizeof(command_s) * tree->command_count;
+    options_offset = (options_offset + _Alignof(option_s) - 1) / _Alignof(option_s) * _Alignof(option_s);
+
+    // followed by the option bitsets of every command
+    size_t bits_offset = options_offset + sizeof(option_s) * option_total;
+    bits_offset = (bits_offset + _Alignof(uint64_t) - 1) / _Alignof(uint64_t) * _Alignof(uint64_t);
+
+    unsigned char* block = malloc(bits_offset + sizeof(uint64_t) * word_total);
+    if (block == NULL)
+        return false;
+
+    PARSE_STATS_ALLOCATION(bits_offset + sizeof(uint64_t) * word_total);
+
+    command_s* commands = (command_s*)block;
+    option_s* options = (option_s*)(block + options_offset);
+    uint64_t* bits = (uint64_t*)(block + bits_offset);
+
+    memcpy(commands, tree->commands, sizeof(command_s) * tree->command_count);
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        if (commands[i].option_count > 0)
+            memcpy(options, commands[i].options, sizeof(option_s) * commands[i].option_count);
+
+        free(commands[i].options);
+        commands[i].is_compacted = true;
+        commands[i].options = commands[i].option_count > 0 ? options : NULL;
+        commands[i].option_capacity = commands[i].option_count;
+        options += commands[i].option_count;
+
+        size_t word_count = commands[i].option_word_count;
+        if (word_count == 0)
             continue;
 
-        found_target = true;
-        tree->commands[i].is_set = true;
-        arguments_init(&tree->commands[i].parsed_arguments, searching_flag_name, argc-1, argv+1);
+        memcpy(bits, commands[i].required_options, sizeof(uint64_t) * word_count * 3);
+        free(commands[i].required_options);
+        commands[i].required_options = bits;
+        commands[i].present_options = bits + word_count;
+        commands[i].defaulted_options = bits + word_count * 2;
+        bits += word_count * 3;
+    }
 
-        break;
+    free(tree->commands);
+    tree->commands = commands;
+    tree->command_capacity = tree->command_count;
+    tree->command_block_size = bits_offset + sizeof(uint64_t) * word_total;
+    return true;
+}
+
+bool command_tree_intern_strings_(command_tree_s* tree)
+{
+    // nothing is moved until the pool is allocated, so a failure leaves every notation as it was
+    size_t name_count = 0;
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        name_count += tree->commands[i].notation.alias_count + 2;
+        for (size_t j = 0; j < tree->commands[i].option_count; ++j)
+        {
+            const notation_s* notation = command_tree_poolable_notation_(&tree->commands[i].options[j]);
+            if (notation != NULL)
+                name_count += notation->alias_count + 2;
+        }
     }
 
-    return found_target;
+    string_set_s strings = {0};
+    if (!string_set_init(&strings, name_count))
+        return false;
+
+    size_t pool_size = 0;
+    bool success = true;
+    for (size_t i = 0; i < tree->command_count && success; ++i)
+    {
+        success = notation_measure_pooled(&tree->commands[i].notation, &strings, &pool_size);
+        for (size_t j = 0; j < tree->commands[i].option_count && success; ++j)
+            success = notation_measure_pooled(command_tree_poolable_notation_(&tree->commands[i].options[j]), &strings, &pool_size);
+    }
+
+    size_t unique_count = string_set_count(&strings);
+    string_set_clean(&strings);
+    if (!success || pool_size == 0 || tree->string_pool != NULL)
+        return success;
+
+    char* pool = malloc(pool_size);
+    if (pool != NULL)
+        PARSE_STATS_ALLOCATION(pool_size);
+    if (pool == NULL || !string_set_init(&strings, unique_count))
+    {
+        free(pool);
+        return false;
+    }
+
+    size_t pool_used = 0;
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        notation_intern(&tree->commands[i].notation, &strings, pool, &pool_used);
+        for (size_t j = 0; j < tree->commands[i].option_count; ++j)
+            notation_intern(command_tree_poolable_notation_(&tree->commands[i].options[j]), &strings, pool, &pool_used);
+    }
+
+    string_set_clean(&strings);
+    tree->string_pool = pool;
+    tree->string_pool_size = pool_used;
+    return true;
 }
 
-command_s* command_tree_get_called_command(command_tree_s* tree)
+notation_s* command_tree_poolable_notation_(option_s* option)
 {
-    if (tree == NULL || tree->commands == NULL || tree->command_count == 0)
+    // a notation shared by more than one option may be shared with another tree, which would be left pointing into this pool
+    if (shared_value_use_count(&option->shared_notation) != 1)
         return NULL;
 
+    return shared_value_read(&option->shared_notation);
+}
+
+void command_tree_clean_image_(command_tree_s* tree)
+{
+    // only the parse state is owned by the tree, everything else points into the image or the loaded block
     for (size_t i = 0; i < tree->command_count; ++i)
-        if (tree->commands[i].is_set)
-            return &tree->commands[i];
+    {
+        command_s* command = &tree->commands[i];
+        for (size_t j = 0; j < command->option_count; ++j)
+            option_reset(&command->options[j]);
 
-    return NULL;
+        arguments_clean(&command->parsed_arguments);
+        diagnostics_clean(&command->diagnostics);
+    }
+
+    free(tree->commands);
+    free(tree->line_tokens);
+    if (tree->image_is_mapped)
+        schema_image_unmap(tree->image, tree->image_length);
+
+    arguments_clean(&tree->parsed_arguments);
+    diagnostics_clean(&tree->diagnostics);
+
+    // the statistics outlive the tree, so the time spent cleaning can still be read
+    *tree = (command_tree_s){ .stats = tree->stats };
 }
+
+// END LOCAL IMPLEMENTATIONS //
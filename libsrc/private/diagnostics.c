@@ -0,0 +1,235 @@
+#include "diagnostics.h"
+
+#include "extra/dynamic_array.h"
+
+#include <stdlib.h>
+
+// LOCAL DEFINITIONS //
+
+static const char* DIAGNOSTIC_MESSAGES[MAX_DIAGNOSTIC_CODE_COUNT] = {
+    [DIAGNOSTIC_UNKNOWN_OPTION]  = "Found unknown option",
+    [DIAGNOSTIC_REPEATED_OPTION] = "Option already seen previously, ignoring option",
+    [DIAGNOSTIC_INVALID_VALUE]   = "Failed to parse flag, value invalid",
+    [DIAGNOSTIC_UNKNOWN_COMMAND] = "Found unknown command",
+    [DIAGNOSTIC_MISSING_COMMAND] = "No command was passed",
+    [DIAGNOSTIC_MISSING_HANDLER] = "Command has no handler",
+    [DIAGNOSTIC_MISSING_NAME]    = "Found a flag without a name",
+    [DIAGNOSTIC_INVALID_ALIAS]   = "Flag has an alias that does not begin with `-`",
+    [DIAGNOSTIC_DUPLICATE_FLAG]  = "Flag is registered more than once",
+    [DIAGNOSTIC_OUT_OF_MEMORY]   = "Ran out of memory",
+    [DIAGNOSTIC_INVALID_LINE]    = "Found an unclosed quote or a trailing backslash in the line",
+    [DIAGNOSTIC_MISSING_POSITIONAL] = "Missing positional argument",
+    [DIAGNOSTIC_EXTRA_POSITIONAL]   = "Found more positional arguments than expected",
+    [DIAGNOSTIC_EXCLUSIVE_OPTIONS]  = "Found options that can't be passed together",
+    [DIAGNOSTIC_MISSING_DEPENDENCY] = "Option can't be passed without the options it requires",
+    [DIAGNOSTIC_MISSING_ONE_OF]     = "Expected at least one of the options"
+};
+
+static const char* DIAGNOSTIC_TYPE_NAMES[MAX_OPTION_TYPE_COUNT] = {
+    [OPTION_TYPE_BOOL]         = "flag",
+    [OPTION_TYPE_INT]          = "number",
+    [OPTION_TYPE_FLOAT]        = "floating-point number",
+    [OPTION_TYPE_STRING]       = "text",
+    [OPTION_TYPE_MULTI_STRING] = "one or more texts",
+    [OPTION_TYPE_CHOICE]       = "one of its choices",
+    [OPTION_TYPE_SIZE]         = "a size like `512MiB`",
+    [OPTION_TYPE_DURATION]     = "a duration like `1h30m`",
+    [OPTION_TYPE_CUSTOM]       = "a value of its own type"
+};
+
+static int diagnostic_format_choices_(const diagnostic_s* diagnostic, const char* message, const char* flag,
+                                      char* buffer, size_t buffer_length);
+static int diagnostic_format_list_(int head_length, const char* const* items, size_t item_count,
+                                   char* buffer, size_t buffer_length);
+
+// END LOCAL DEFINITIONS //
+
+bool diagnostics_push(diagnostics_s* diagnostics, diagnostic_code_e code, size_t argv_index, const char* flag, option_type_e expected_type)
+{
+    if (diagnostics == NULL || code >= MAX_DIAGNOSTIC_CODE_COUNT)
+        return false;
+
+    if (!dynamic_array_reserve((void**)&diagnostics->entries, &diagnostics->capacity, sizeof(diagnostic_s), diagnostics->count + 1))
+        return false;
+
+    diagnostics->entries[diagnostics->count++] = (diagnostic_s){
+        .code = code,
+        .argv_index = argv_index,
+        .flag = flag,
+        .expected_type = expected_type,
+        .choices = NULL,
+        .custom_type = NULL,
+        .related_flags = NULL,
+        .related_flag_count = 0
+    };
+    return true;
+}
+
+bool diagnostics_push_constraint(diagnostics_s* diagnostics, diagnostic_code_e code, const char* flag,
+                                 const char* const* related_flags, size_t related_flag_count)
+{
+    if (!diagnostics_push(diagnostics, code, DIAGNOSTIC_NO_ARGV_INDEX, flag, MAX_OPTION_TYPE_COUNT))
+        return false;
+
+    diagnostics->entries[diagnostics->count - 1].related_flags = related_flags;
+    diagnostics->entries[diagnostics->count - 1].related_flag_count = related_flag_count;
+    return true;
+}
+
+bool diagnostics_push_invalid_value(diagnostics_s* diagnostics, size_t argv_index, const char* flag, const option_s* option)
+{
+    if (option == NULL || !diagnostics_push(diagnostics, DIAGNOSTIC_INVALID_VALUE, argv_index, flag, option->type))
+        return false;
+
+    diagnostics->entries[diagnostics->count - 1].choices = option->choices;
+    diagnostics->entries[diagnostics->count - 1].custom_type = option->custom_type;
+    return true;
+}
+
+bool diagnostics_append(diagnostics_s* restrict dest, const diagnostics_s* restrict src)
+{
+    if (dest == NULL || src == NULL)
+        return false;
+
+    if (!dynamic_array_reserve((void**)&dest->entries, &dest->capacity, sizeof(diagnostic_s), dest->count + src->count))
+        return false;
+
+    for (size_t i = 0; i < src->count; ++i)
+        dest->entries[dest->count++] = src->entries[i];
+
+    return true;
+}
+
+void diagnostics_clear(diagnostics_s* diagnostics)
+{
+    if (diagnostics == NULL)
+        return;
+
+    diagnostics->count = 0;
+}
+
+void diagnostics_clean(diagnostics_s* diagnostics)
+{
+    if (diagnostics == NULL)
+        return;
+
+    free(diagnostics->entries);
+    diagnostics->entries = NULL;
+    diagnostics->count = 0;
+    diagnostics->capacity = 0;
+}
+
+size_t diagnostics_count(const diagnostics_s* diagnostics)
+{
+    if (diagnostics == NULL)
+        return 0;
+
+    return diagnostics->count;
+}
+
+const diagnostic_s* diagnostics_get(const diagnostics_s* diagnostics, size_t index)
+{
+    if (diagnostics == NULL || index >= diagnostics->count)
+        return NULL;
+
+    return &diagnostics->entries[index];
+}
+
+bool diagnostics_has_errors(const diagnostics_s* diagnostics)
+{
+    if (diagnostics == NULL)
+        return false;
+
+    for (size_t i = 0; i < diagnostics->count; ++i)
+        if (!diagnostic_is_warning(diagnostics->entries[i].code))
+            return true;
+
+    return false;
+}
+
+bool diagnostic_is_warning(diagnostic_code_e code)
+{
+    return code == DIAGNOSTIC_REPEATED_OPTION;
+}
+
+int diagnostic_format(const diagnostic_s* diagnostic, char* buffer, size_t buffer_length)
+{
+    if (diagnostic == NULL || diagnostic->code >= MAX_DIAGNOSTIC_CODE_COUNT)
+        return -1;
+
+    const char* message = DIAGNOSTIC_MESSAGES[diagnostic->code];
+    const char* flag = diagnostic->flag != NULL ? diagnostic->flag : "";
+
+    if (diagnostic->choices != NULL && diagnostic->code == DIAGNOSTIC_INVALID_VALUE)
+        return diagnostic_format_choices_(diagnostic, message, flag, buffer, buffer_length);
+
+    if (diagnostic->related_flags != NULL && diagnostic->related_flag_count > 0)
+    {
+        int written = diagnostic->flag != NULL
+                      ? snprintf(buffer, buffer_length, "%s: `%s` needs", message, flag)
+                      : snprintf(buffer, buffer_length, "%s:", message);
+        return diagnostic_format_list_(written, diagnostic->related_flags, diagnostic->related_flag_count, buffer, buffer_length);
+    }
+
+    if (diagnostic->custom_type != NULL && diagnostic->custom_type->name != NULL && diagnostic->code == DIAGNOSTIC_INVALID_VALUE)
+        return snprintf(buffer, buffer_length, "%s: `%s` expects %s", message, flag, diagnostic->custom_type->name);
+
+    if (diagnostic->expected_type < MAX_OPTION_TYPE_COUNT && diagnostic->code == DIAGNOSTIC_INVALID_VALUE)
+        return snprintf(buffer, buffer_length, "%s: `%s` expects %s",
+                        message, flag, DIAGNOSTIC_TYPE_NAMES[diagnostic->expected_type]);
+
+    if (diagnostic->flag != NULL)
+        return snprintf(buffer, buffer_length, "%s: `%s`", message, flag);
+
+    return snprintf(buffer, buffer_length, "%s", message);
+}
+
+void diagnostics_print(FILE* stream, const diagnostics_s* diagnostics)
+{
+    if (stream == NULL || diagnostics == NULL)
+        return;
+
+    char message[256];
+    for (size_t i = 0; i < diagnostics->count; ++i)
+    {
+        if (diagnostic_format(&diagnostics->entries[i], message, sizeof(message)) < 0)
+            continue;
+
+        fprintf(stream, "%s%s\n", diagnostic_is_warning(diagnostics->entries[i].code) ? "warning: " : "", message);
+    }
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+int diagnostic_format_choices_(const diagnostic_s* diagnostic, const char* message, const char* flag,
+                               char* buffer, size_t buffer_length)
+{
+    int written = snprintf(buffer, buffer_length, "%s: `%s` expects one of", message, flag);
+    return diagnostic_format_list_(written, (const char* const*)diagnostic->choices->names, diagnostic->choices->count,
+                                   buffer, buffer_length);
+}
+
+int diagnostic_format_list_(int head_length, const char* const* items, size_t item_count,
+                            char* buffer, size_t buffer_length)
+{
+    if (head_length < 0)
+        return head_length;
+
+    // keeps writing into what's left of the buffer, while counting the complete length like `snprintf()`
+    size_t total_length = (size_t)head_length;
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        const char* separator = i > 0 ? "," : "";
+        int written = buffer == NULL || total_length >= buffer_length
+                      ? snprintf(NULL, 0, "%s `%s`", separator, items[i])
+                      : snprintf(buffer + total_length, buffer_length - total_length, "%s `%s`", separator, items[i]);
+        if (written < 0)
+            return written;
+
+        total_length += (size_t)written;
+    }
+
+    return (int)total_length;
+}
+
+// END LOCAL IMPLEMENTATIONS //
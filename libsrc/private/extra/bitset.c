@@ -0,0 +1,124 @@
+#include "extra/bitset.h"
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// LOCAL DEFINITIONS //
+
+static size_t bitset_lowest_bit_(uint64_t word);
+static size_t bitset_popcount_(uint64_t word);
+
+// END LOCAL DEFINITIONS //
+
+size_t bitset_word_count(size_t bit_count)
+{
+    return (bit_count + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+
+void bitset_set(uint64_t* words, size_t index)
+{
+    words[index / BITSET_WORD_BITS] |= (uint64_t)1 << (index % BITSET_WORD_BITS);
+}
+
+void bitset_reset(uint64_t* words, size_t index)
+{
+    words[index / BITSET_WORD_BITS] &= ~((uint64_t)1 << (index % BITSET_WORD_BITS));
+}
+
+bool bitset_test(const uint64_t* words, size_t index)
+{
+    return (words[index / BITSET_WORD_BITS] >> (index % BITSET_WORD_BITS)) & 1;
+}
+
+void bitset_clear(uint64_t* words, size_t word_count)
+{
+    if (words == NULL || word_count == 0)
+        return;
+
+    memset(words, 0, sizeof(uint64_t) * word_count);
+}
+
+size_t bitset_count_and(const uint64_t* words, const uint64_t* mask, size_t word_count)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < word_count; ++i)
+        count += bitset_popcount_(words[i] & mask[i]);
+
+    return count;
+}
+
+bool bitset_any_and_not(const uint64_t* words, const uint64_t* mask, size_t word_count)
+{
+    for (size_t i = 0; i < word_count; ++i)
+        if ((words[i] & ~mask[i]) != 0)
+            return true;
+
+    return false;
+}
+
+size_t bitset_collect_and_not(const uint64_t* words, const uint64_t* mask, size_t word_count, size_t* indices, size_t index_capacity)
+{
+    size_t collected = 0;
+    for (size_t i = 0; i < word_count && collected < index_capacity; ++i)
+    {
+        uint64_t word = words[i] & ~mask[i];
+        while (word != 0 && collected < index_capacity)
+        {
+            indices[collected++] = i * BITSET_WORD_BITS + bitset_lowest_bit_(word);
+            word &= word - 1;
+        }
+    }
+
+    return collected;
+}
+
+void bitset_complement(uint64_t* dest, const uint64_t* src, size_t bit_count)
+{
+    size_t word_count = bitset_word_count(bit_count);
+    for (size_t i = 0; i < word_count; ++i)
+        dest[i] = ~src[i];
+
+    // never mark the bits past the end of the set
+    if (bit_count % BITSET_WORD_BITS != 0)
+        dest[word_count - 1] &= ((uint64_t)1 << (bit_count % BITSET_WORD_BITS)) - 1;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+size_t bitset_lowest_bit_(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return (size_t)index;
+#else
+    size_t index = 0;
+    while ((word & 1) == 0)
+    {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+size_t bitset_popcount_(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (size_t)__popcnt64(word);
+#else
+    size_t count = 0;
+    for (; word != 0; word &= word - 1)
+        count++;
+    return count;
+#endif
+}
+
+// END LOCAL IMPLEMENTATIONS //
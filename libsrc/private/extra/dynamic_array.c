@@ -0,0 +1,71 @@
+#include "extra/dynamic_array.h"
+
+#include "parse_stats.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+// LOCAL DEFINITIONS //
+
+#define DYNAMIC_ARRAY_MIN_CAPACITY 4
+
+// END LOCAL DEFINITIONS //
+
+bool dynamic_array_reserve(void** data, size_t* capacity, size_t element_size, size_t required_capacity)
+{
+    if (data == NULL || capacity == NULL || element_size == 0)
+        return false;
+
+    if (required_capacity <= *capacity)
+        return true;
+
+    // grow geometrically so appending stays amortized O(1)
+    size_t new_capacity = *capacity < DYNAMIC_ARRAY_MIN_CAPACITY ? DYNAMIC_ARRAY_MIN_CAPACITY : *capacity;
+    while (new_capacity < required_capacity)
+    {
+        if (new_capacity > SIZE_MAX / 2)
+        {
+            new_capacity = required_capacity;
+            break;
+        }
+        new_capacity *= 2;
+    }
+
+    if (new_capacity > SIZE_MAX / element_size)
+        return false;
+
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (grown == NULL)
+        return false;
+
+    PARSE_STATS_ALLOCATION(new_capacity * element_size);
+
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+bool dynamic_array_shrink(void** data, size_t* capacity, size_t element_size, size_t count)
+{
+    if (data == NULL || capacity == NULL || element_size == 0 || count > *capacity)
+        return false;
+
+    if (count == *capacity)
+        return true;
+
+    if (count == 0)
+    {
+        free(*data);
+        *data = NULL;
+        *capacity = 0;
+        return true;
+    }
+
+    void* shrunk = realloc(*data, count * element_size);
+    if (shrunk == NULL)
+        return false;
+
+    *data = shrunk;
+    *capacity = count;
+    return true;
+}
@@ -0,0 +1,162 @@
+#include "extra/line_tokenizer.h"
+
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+typedef enum line_char_class_
+{
+    LINE_CHAR_PLAIN,
+    LINE_CHAR_SPACE,
+    LINE_CHAR_SINGLE_QUOTE,
+    LINE_CHAR_DOUBLE_QUOTE,
+    LINE_CHAR_BACKSLASH
+} line_char_class_e;
+
+// every character that needs handling is looked up in a single table, everything else is copied as a run
+static const unsigned char LINE_CHAR_CLASSES[256] = {
+    [' ']  = LINE_CHAR_SPACE,
+    ['\t'] = LINE_CHAR_SPACE,
+    ['\n'] = LINE_CHAR_SPACE,
+    ['\r'] = LINE_CHAR_SPACE,
+    ['\''] = LINE_CHAR_SINGLE_QUOTE,
+    ['"']  = LINE_CHAR_DOUBLE_QUOTE,
+    ['\\'] = LINE_CHAR_BACKSLASH
+};
+
+static size_t line_plain_run_(const char* line, size_t position, size_t length);
+static size_t line_skip_separators_(const char* line, size_t position, size_t length);
+static bool line_read_quoted_(char* line, size_t length, size_t* read, size_t* write, char quote);
+
+// END LOCAL DEFINITIONS //
+
+size_t line_tokenizer_capacity(size_t length)
+{
+    // every token but the last is followed by at least one separator
+    return length / 2 + 1;
+}
+
+size_t line_tokenize(char* line, size_t length, const char** tokens, size_t token_capacity)
+{
+    if (line == NULL || (tokens == NULL && token_capacity > 0))
+        return LINE_TOKENIZE_ERROR;
+
+    size_t token_count = 0;
+    size_t read = 0;
+    size_t write = 0;
+
+    while (read < length)
+    {
+        read = line_skip_separators_(line, read, length);
+
+        if (read >= length)
+            break;
+
+        if (token_count >= token_capacity)
+            return LINE_TOKENIZE_ERROR;
+
+        tokens[token_count++] = line + write;
+        bool is_token_done = false;
+        while (read < length && !is_token_done)
+        {
+            switch (LINE_CHAR_CLASSES[(unsigned char)line[read]])
+            {
+            case LINE_CHAR_PLAIN:
+            {
+                // nothing was removed from the line so far, the run is already where it belongs
+                size_t run = line_plain_run_(line, read, length);
+                if (write != read)
+                    memmove(line + write, line + read, run);
+
+                read += run;
+                write += run;
+            }
+            break;
+            case LINE_CHAR_SPACE:
+                is_token_done = true;
+            break;
+            case LINE_CHAR_BACKSLASH:
+                if (read + 1 >= length)
+                    return LINE_TOKENIZE_ERROR;
+
+                if (line[read + 1] != '\n')
+                    line[write++] = line[read + 1];
+
+                read += 2;
+            break;
+            case LINE_CHAR_SINGLE_QUOTE:
+            case LINE_CHAR_DOUBLE_QUOTE:
+                if (!line_read_quoted_(line, length, &read, &write, line[read]))
+                    return LINE_TOKENIZE_ERROR;
+            break;
+
+            default:
+            break;
+            }
+        }
+
+        // the separator, or the end of the line, is never in front of the write position
+        line[write++] = '\0';
+        read++;
+    }
+
+    return token_count;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+size_t line_plain_run_(const char* line, size_t position, size_t length)
+{
+    size_t end = position;
+    while (end < length && LINE_CHAR_CLASSES[(unsigned char)line[end]] == LINE_CHAR_PLAIN)
+        end++;
+
+    return end - position;
+}
+
+size_t line_skip_separators_(const char* line, size_t position, size_t length)
+{
+    // a line continuation is removed without a trace, so on its own it doesn't start a token
+    while (position < length)
+    {
+        if (LINE_CHAR_CLASSES[(unsigned char)line[position]] == LINE_CHAR_SPACE)
+            position++;
+        else if (line[position] == '\\' && position + 1 < length && line[position + 1] == '\n')
+            position += 2;
+        else
+            break;
+    }
+
+    return position;
+}
+
+bool line_read_quoted_(char* line, size_t length, size_t* read, size_t* write, char quote)
+{
+    size_t position = *read + 1;
+    size_t output = *write;
+
+    while (position < length && line[position] != quote)
+    {
+        // within double quotes, a backslash only escapes what would otherwise end or change the quote
+        if (quote == '"' && line[position] == '\\' && position + 1 < length &&
+            (line[position + 1] == '"' || line[position + 1] == '\\' || line[position + 1] == '\n'))
+        {
+            if (line[position + 1] != '\n')
+                line[output++] = line[position + 1];
+
+            position += 2;
+            continue;
+        }
+
+        line[output++] = line[position++];
+    }
+
+    if (position >= length)
+        return false;
+
+    *read = position + 1;
+    *write = output;
+    return true;
+}
+
+// END LOCAL IMPLEMENTATIONS //
@@ -0,0 +1,174 @@
+#include "extra/perfect_hash.h"
+
+#include "extra/string_set.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+#define PERFECT_HASH_MIN_SLOT_COUNT        4
+#define PERFECT_HASH_KEYS_PER_BUCKET       4
+#define PERFECT_HASH_DISPLACEMENT_ATTEMPTS 4096
+
+typedef struct perfect_hash_bucket_
+{
+    uint32_t size;
+    uint32_t index;
+} perfect_hash_bucket_s;
+
+static size_t perfect_hash_bucket_of_(uint64_t hash, size_t bucket_count);
+static size_t perfect_hash_slot_of_(uint64_t hash, uint32_t displacement, size_t slot_count);
+static int perfect_hash_compare_buckets_(const void* left, const void* right);
+static bool perfect_hash_place_bucket_(const uint64_t* hashes, const uint32_t* keys, size_t key_count,
+                                       uint32_t* slots, size_t slot_count, uint32_t* placed, uint32_t* displacement);
+
+// END LOCAL DEFINITIONS //
+
+size_t perfect_hash_slot_count(size_t key_count)
+{
+    // start out at most half full, `perfect_hash_build()` failing means the caller should try twice as many slots
+    size_t slot_count = PERFECT_HASH_MIN_SLOT_COUNT;
+    while (slot_count < key_count * 2)
+        slot_count *= 2;
+
+    return slot_count;
+}
+
+size_t perfect_hash_bucket_count(size_t key_count)
+{
+    size_t bucket_count = 1;
+    while (bucket_count * PERFECT_HASH_KEYS_PER_BUCKET < key_count)
+        bucket_count *= 2;
+
+    return bucket_count;
+}
+
+bool perfect_hash_build(const char* const* keys, size_t key_count, uint32_t* slots, size_t slot_count,
+                        uint32_t* displacements, size_t bucket_count)
+{
+    if (keys == NULL || slots == NULL || displacements == NULL || bucket_count == 0 ||
+        key_count > slot_count || key_count >= UINT32_MAX)
+        return false;
+
+    memset(slots, 0, sizeof(uint32_t) * slot_count);
+    memset(displacements, 0, sizeof(uint32_t) * bucket_count);
+    if (key_count == 0)
+        return true;
+
+    // the hashes, the keys ordered by bucket, where every bucket starts in that order, the buckets and the slots being placed
+    size_t scratch_size = sizeof(uint64_t) * key_count + sizeof(uint32_t) * key_count + sizeof(uint32_t) * (bucket_count + 1) +
+                          sizeof(perfect_hash_bucket_s) * bucket_count + sizeof(uint32_t) * key_count;
+    unsigned char* scratch = malloc(scratch_size);
+    if (scratch == NULL)
+        return false;
+
+    uint64_t* hashes = (uint64_t*)scratch;
+    uint32_t* ordered_keys = (uint32_t*)(hashes + key_count);
+    uint32_t* bucket_starts = ordered_keys + key_count;
+    perfect_hash_bucket_s* buckets = (perfect_hash_bucket_s*)(bucket_starts + bucket_count + 1);
+    uint32_t* placed = (uint32_t*)(buckets + bucket_count);
+
+    for (size_t i = 0; i < bucket_count; ++i)
+        buckets[i] = (perfect_hash_bucket_s){ .size = 0, .index = (uint32_t)i };
+
+    for (size_t i = 0; i < key_count; ++i)
+    {
+        hashes[i] = string_set_hash(keys[i], strlen(keys[i]));
+        buckets[perfect_hash_bucket_of_(hashes[i], bucket_count)].size++;
+    }
+
+    // a counting sort groups the keys per bucket
+    bucket_starts[0] = 0;
+    for (size_t i = 0; i < bucket_count; ++i)
+        bucket_starts[i + 1] = bucket_starts[i] + buckets[i].size;
+
+    for (size_t i = 0; i < key_count; ++i)
+    {
+        size_t bucket = perfect_hash_bucket_of_(hashes[i], bucket_count);
+        ordered_keys[bucket_starts[bucket + 1] - buckets[bucket].size] = (uint32_t)i;
+        buckets[bucket].size--;
+    }
+
+    for (size_t i = 0; i < bucket_count; ++i)
+        buckets[i].size = bucket_starts[i + 1] - bucket_starts[i];
+
+    // the largest buckets are placed while the table is still mostly empty
+    qsort(buckets, bucket_count, sizeof(perfect_hash_bucket_s), perfect_hash_compare_buckets_);
+
+    bool is_built = true;
+    for (size_t i = 0; i < bucket_count && is_built && buckets[i].size > 0; ++i)
+    {
+        uint32_t index = buckets[i].index;
+        is_built = perfect_hash_place_bucket_(hashes, ordered_keys + bucket_starts[index], buckets[i].size,
+                                              slots, slot_count, placed, &displacements[index]);
+    }
+
+    free(scratch);
+    return is_built;
+}
+
+size_t perfect_hash_slot(const char* key, size_t length, const uint32_t* displacements, size_t bucket_count, size_t slot_count)
+{
+    uint64_t hash = string_set_hash(key, length);
+    return perfect_hash_slot_of_(hash, displacements[perfect_hash_bucket_of_(hash, bucket_count)], slot_count);
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+size_t perfect_hash_bucket_of_(uint64_t hash, size_t bucket_count)
+{
+    // a different multiplier than the slots, so keys sharing a bucket don't share a slot as well
+    return (size_t)((hash * 0x94D049BB133111EBu) >> 32) & (bucket_count - 1);
+}
+
+size_t perfect_hash_slot_of_(uint64_t hash, uint32_t displacement, size_t slot_count)
+{
+    // mixing the displacement in after hashing keeps trying another one as cheap as a multiplication per key
+    uint64_t mixed = (hash ^ ((uint64_t)displacement * 0x9E3779B97F4A7C15u)) * 0xBF58476D1CE4E5B9u;
+    return (size_t)(mixed >> 32) & (slot_count - 1);
+}
+
+int perfect_hash_compare_buckets_(const void* left, const void* right)
+{
+    const perfect_hash_bucket_s* left_bucket = left;
+    const perfect_hash_bucket_s* right_bucket = right;
+
+    if (left_bucket->size != right_bucket->size)
+        return left_bucket->size > right_bucket->size ? -1 : 1;
+
+    // equal sizes keep their index order, so the same keys always build the same table
+    return left_bucket->index < right_bucket->index ? -1 : 1;
+}
+
+bool perfect_hash_place_bucket_(const uint64_t* hashes, const uint32_t* keys, size_t key_count,
+                                uint32_t* slots, size_t slot_count, uint32_t* placed, uint32_t* displacement)
+{
+    for (uint32_t attempt = 0; attempt < PERFECT_HASH_DISPLACEMENT_ATTEMPTS; ++attempt)
+    {
+        size_t placed_count = 0;
+        for (; placed_count < key_count; ++placed_count)
+        {
+            size_t slot = perfect_hash_slot_of_(hashes[keys[placed_count]], attempt, slot_count);
+            if (slots[slot] != 0)
+                break;
+
+            // taken right away, so two keys of the bucket can't end up in the same slot either
+            slots[slot] = keys[placed_count] + 1;
+            placed[placed_count] = (uint32_t)slot;
+        }
+
+        if (placed_count == key_count)
+        {
+            *displacement = attempt;
+            return true;
+        }
+
+        while (placed_count > 0)
+            slots[placed[--placed_count]] = 0;
+    }
+
+    return false;
+}
+
+// END LOCAL IMPLEMENTATIONS //
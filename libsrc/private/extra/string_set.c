@@ -0,0 +1,176 @@
+#include "extra/string_set.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+#define STRING_SET_MIN_CAPACITY 16
+
+static size_t string_set_probe_(const string_set_s* set, const char* value, size_t length, uint64_t hash);
+static bool string_set_rehash_(string_set_s* set, size_t new_capacity);
+
+// END LOCAL DEFINITIONS //
+
+bool string_set_init(string_set_s* set, size_t expected_count)
+{
+    if (set == NULL)
+        return false;
+
+    // keep the load-factor at or below 0.5 for the expected amount of entries
+    size_t capacity = STRING_SET_MIN_CAPACITY;
+    while (capacity < expected_count * 2)
+        capacity *= 2;
+
+    set->capacity_ = 0;
+    set->count_ = 0;
+    set->hashes_ = NULL;
+    set->lengths_ = NULL;
+    set->entries_ = NULL;
+    return string_set_rehash_(set, capacity);
+}
+
+void string_set_clean(string_set_s* set)
+{
+    if (set == NULL)
+        return;
+
+    free(set->hashes_);
+    free(set->lengths_);
+    free(set->entries_);
+
+    set->hashes_ = NULL;
+    set->lengths_ = NULL;
+    set->entries_ = NULL;
+    set->capacity_ = 0;
+    set->count_ = 0;
+}
+
+bool string_set_insert(string_set_s* set, const char* value, size_t length, bool* was_present)
+{
+    if (set == NULL || set->entries_ == NULL || value == NULL)
+        return false;
+
+    uint64_t hash = string_set_hash(value, length);
+    size_t slot = string_set_probe_(set, value, length, hash);
+
+    if (set->entries_[slot] != NULL)
+    {
+        if (was_present != NULL)
+            *was_present = true;
+        return true;
+    }
+
+    if (was_present != NULL)
+        *was_present = false;
+
+    if ((set->count_ + 1) * 2 > set->capacity_)
+    {
+        if (!string_set_rehash_(set, set->capacity_ * 2))
+            return false;
+
+        slot = string_set_probe_(set, value, length, hash);
+    }
+
+    set->hashes_[slot] = hash;
+    set->lengths_[slot] = length;
+    set->entries_[slot] = value;
+    set->count_++;
+    return true;
+}
+
+const char* string_set_find(const string_set_s* set, const char* value, size_t length)
+{
+    if (set == NULL || set->entries_ == NULL || value == NULL)
+        return NULL;
+
+    return set->entries_[string_set_probe_(set, value, length, string_set_hash(value, length))];
+}
+
+bool string_set_contains(const string_set_s* set, const char* value, size_t length)
+{
+    return string_set_find(set, value, length) != NULL;
+}
+
+size_t string_set_count(const string_set_s* set)
+{
+    if (set == NULL)
+        return 0;
+
+    return set->count_;
+}
+
+uint64_t string_set_hash(const char* value, size_t length)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char)value[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+size_t string_set_probe_(const string_set_s* set, const char* value, size_t length, uint64_t hash)
+{
+    // the capacity is always a power of two, so masking replaces the modulo
+    size_t mask = set->capacity_ - 1;
+    size_t slot = (size_t)hash & mask;
+
+    while (set->entries_[slot] != NULL)
+    {
+        if (set->hashes_[slot] == hash &&
+            set->lengths_[slot] == length &&
+            memcmp(set->entries_[slot], value, length) == 0)
+            return slot;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+bool string_set_rehash_(string_set_s* set, size_t new_capacity)
+{
+    uint64_t* hashes = calloc(new_capacity, sizeof(uint64_t));
+    size_t* lengths = calloc(new_capacity, sizeof(size_t));
+    const char** entries = calloc(new_capacity, sizeof(char*));
+    if (hashes == NULL || lengths == NULL || entries == NULL)
+    {
+        free(hashes);
+        free(lengths);
+        free(entries);
+        return false;
+    }
+
+    string_set_s grown = {
+        .capacity_ = new_capacity,
+        .count_ = set->count_,
+        .hashes_ = hashes,
+        .lengths_ = lengths,
+        .entries_ = entries
+    };
+
+    for (size_t i = 0; i < set->capacity_; ++i)
+    {
+        if (set->entries_[i] == NULL)
+            continue;
+
+        size_t slot = string_set_probe_(&grown, set->entries_[i], set->lengths_[i], set->hashes_[i]);
+        grown.hashes_[slot] = set->hashes_[i];
+        grown.lengths_[slot] = set->lengths_[i];
+        grown.entries_[slot] = set->entries_[i];
+    }
+
+    free(set->hashes_);
+    free(set->lengths_);
+    free(set->entries_);
+    *set = grown;
+    return true;
+}
+
+// END LOCAL IMPLEMENTATIONS //
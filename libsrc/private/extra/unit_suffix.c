@@ -0,0 +1,149 @@
+#include "extra/unit_suffix.h"
+
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+typedef struct unit_suffix_
+{
+    const char* name;
+    size_t length;
+    uint64_t multiplier;
+} unit_suffix_s;
+
+#define UNIT_SUFFIX(name, multiplier) { name, sizeof(name) - 1, multiplier }
+
+static const unit_suffix_s UNIT_SUFFIX_SIZES[] = {
+    UNIT_SUFFIX("B",   1ULL),
+    UNIT_SUFFIX("kB",  1000ULL),
+    UNIT_SUFFIX("KB",  1000ULL),
+    UNIT_SUFFIX("MB",  1000ULL * 1000),
+    UNIT_SUFFIX("GB",  1000ULL * 1000 * 1000),
+    UNIT_SUFFIX("TB",  1000ULL * 1000 * 1000 * 1000),
+    UNIT_SUFFIX("PB",  1000ULL * 1000 * 1000 * 1000 * 1000),
+    UNIT_SUFFIX("EB",  1000ULL * 1000 * 1000 * 1000 * 1000 * 1000),
+    UNIT_SUFFIX("KiB", 1ULL << 10),
+    UNIT_SUFFIX("MiB", 1ULL << 20),
+    UNIT_SUFFIX("GiB", 1ULL << 30),
+    UNIT_SUFFIX("TiB", 1ULL << 40),
+    UNIT_SUFFIX("PiB", 1ULL << 50),
+    UNIT_SUFFIX("EiB", 1ULL << 60)
+};
+
+static const unit_suffix_s UNIT_SUFFIX_DURATIONS[] = {
+    UNIT_SUFFIX("ns", 1ULL),
+    UNIT_SUFFIX("us", 1000ULL),
+    UNIT_SUFFIX("ms", 1000ULL * 1000),
+    UNIT_SUFFIX("s",  1000ULL * 1000 * 1000),
+    UNIT_SUFFIX("m",  1000ULL * 1000 * 1000 * 60),
+    UNIT_SUFFIX("h",  1000ULL * 1000 * 1000 * 60 * 60)
+};
+
+#define UNIT_SUFFIX_COUNT(table) (sizeof(table) / sizeof(*(table)))
+
+static size_t unit_suffix_read_number_(const char* text, size_t length, uint64_t* number);
+static size_t unit_suffix_read_name_(const char* text, size_t length);
+static const unit_suffix_s* unit_suffix_find_(const unit_suffix_s* table, size_t count, const char* name, size_t length);
+
+// END LOCAL DEFINITIONS //
+
+bool unit_suffix_parse_size(const char* text, size_t length, uint64_t* bytes)
+{
+    if (text == NULL || bytes == NULL)
+        return false;
+
+    uint64_t number = 0;
+    size_t position = unit_suffix_read_number_(text, length, &number);
+    if (position == 0)
+        return false;
+
+    // a size without suffix is a plain amount of bytes
+    if (position == length)
+    {
+        *bytes = number;
+        return true;
+    }
+
+    const unit_suffix_s* suffix = unit_suffix_find_(UNIT_SUFFIX_SIZES, UNIT_SUFFIX_COUNT(UNIT_SUFFIX_SIZES),
+                                                    text + position, length - position);
+    if (suffix == NULL || number > UINT64_MAX / suffix->multiplier)
+        return false;
+
+    *bytes = number * suffix->multiplier;
+    return true;
+}
+
+bool unit_suffix_parse_duration(const char* text, size_t length, uint64_t* nanoseconds)
+{
+    if (text == NULL || nanoseconds == NULL || length == 0)
+        return false;
+
+    if (length == 1 && text[0] == '0')
+    {
+        *nanoseconds = 0;
+        return true;
+    }
+
+    // every part is a number directly followed by its unit, the parts add up
+    uint64_t total = 0;
+    size_t position = 0;
+    while (position < length)
+    {
+        uint64_t number = 0;
+        size_t number_length = unit_suffix_read_number_(text + position, length - position, &number);
+        if (number_length == 0)
+            return false;
+
+        position += number_length;
+        size_t name_length = unit_suffix_read_name_(text + position, length - position);
+        const unit_suffix_s* suffix = unit_suffix_find_(UNIT_SUFFIX_DURATIONS, UNIT_SUFFIX_COUNT(UNIT_SUFFIX_DURATIONS),
+                                                        text + position, name_length);
+        if (suffix == NULL || number > UINT64_MAX / suffix->multiplier ||
+            number * suffix->multiplier > UINT64_MAX - total)
+            return false;
+
+        total += number * suffix->multiplier;
+        position += name_length;
+    }
+
+    *nanoseconds = total;
+    return true;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+size_t unit_suffix_read_number_(const char* text, size_t length, uint64_t* number)
+{
+    uint64_t value = 0;
+    size_t position = 0;
+    for (; position < length && text[position] >= '0' && text[position] <= '9'; ++position)
+    {
+        uint64_t digit = (uint64_t)(text[position] - '0');
+        if (value > (UINT64_MAX - digit) / 10)
+            return 0;
+
+        value = value * 10 + digit;
+    }
+
+    *number = value;
+    return position;
+}
+
+size_t unit_suffix_read_name_(const char* text, size_t length)
+{
+    size_t position = 0;
+    for (; position < length && (text[position] < '0' || text[position] > '9'); ++position) {};
+
+    return position;
+}
+
+const unit_suffix_s* unit_suffix_find_(const unit_suffix_s* table, size_t count, const char* name, size_t length)
+{
+    for (size_t i = 0; i < count; ++i)
+        if (table[i].length == length && memcmp(table[i].name, name, length) == 0)
+            return &table[i];
+
+    return NULL;
+}
+
+// END LOCAL IMPLEMENTATIONS //
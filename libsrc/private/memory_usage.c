@@ -0,0 +1,279 @@
+#include "memory_usage.h"
+
+#include "notation.h"
+#include "option.h"
+
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+static const char* const memory_usage_category_names_[MAX_MEMORY_USAGE_CATEGORY_COUNT] = {
+    [MEMORY_USAGE_STRUCTURES] = "structures",
+    [MEMORY_USAGE_NAMES] = "names",
+    [MEMORY_USAGE_ALIASES] = "aliases",
+    [MEMORY_USAGE_DESCRIPTIONS] = "descriptions",
+    [MEMORY_USAGE_STRING_POOL] = "string_pool",
+    [MEMORY_USAGE_SHARED_VALUES] = "shared_values",
+    [MEMORY_USAGE_DEFAULTS] = "defaults",
+    [MEMORY_USAGE_INDICES] = "indices",
+    [MEMORY_USAGE_VALUES] = "values",
+    [MEMORY_USAGE_PARAMETERS] = "parameters",
+    [MEMORY_USAGE_DIAGNOSTICS] = "diagnostics",
+};
+
+static void memory_usage_add_(memory_usage_s* usage, memory_usage_category_e category, size_t bytes);
+static size_t memory_usage_string_(const char* string);
+static void memory_usage_notation_(const notation_s* notation, memory_usage_s* usage);
+static void memory_usage_defaults_(const option_s* option, memory_usage_s* usage);
+static void memory_usage_option_(const option_s* option, bool is_loaded, bool count_shared, memory_usage_s* usage);
+static void memory_usage_positional_(const positional_s* positional, memory_usage_s* usage);
+static void memory_usage_command_(const command_s* command, const command_s* previous_commands, size_t previous_count, memory_usage_s* usage);
+static bool memory_usage_is_shared_earlier_(const option_s* option, const command_s* previous_commands, size_t previous_count);
+
+// END LOCAL DEFINITIONS //
+
+bool command_tree_memory_usage(const command_tree_s* tree, memory_usage_s* usage)
+{
+    if (tree == NULL || usage == NULL)
+        return false;
+
+    *usage = (memory_usage_s){0};
+
+    // a frozen or loaded tree keeps its commands, options and option bitsets in a single block
+    if (tree->command_block_size != 0)
+        memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, tree->command_block_size);
+    else
+        memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, sizeof(command_s) * tree->command_capacity);
+
+    // the description and command-index of a loaded tree point into the image
+    if (tree->image == NULL)
+    {
+        if (!tree->is_borrowed)
+            memory_usage_add_(usage, MEMORY_USAGE_DESCRIPTIONS, memory_usage_string_(tree->description));
+        if (tree->command_index != NULL)
+            memory_usage_add_(usage, MEMORY_USAGE_INDICES, sizeof(uint32_t) * tree->command_index_capacity * NOTATION_INDEX_LANES);
+    }
+
+    if (tree->string_pool != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_STRING_POOL, tree->string_pool_size);
+
+    if (tree->line_tokens != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_PARAMETERS, sizeof(char*) * tree->line_token_capacity);
+
+    if (tree->parsed_arguments.parameters != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_PARAMETERS, sizeof(char*) * tree->parsed_arguments.argv_count);
+
+    memory_usage_add_(usage, MEMORY_USAGE_DIAGNOSTICS, sizeof(diagnostic_s) * tree->diagnostics.capacity);
+
+    memory_usage_command_(&tree->globals, NULL, 0, usage);
+    for (size_t i = 0; i < tree->command_count; ++i)
+        memory_usage_command_(&tree->commands[i], tree->commands, i, usage);
+
+    return true;
+}
+
+bool command_memory_usage(const command_s* command, memory_usage_s* usage)
+{
+    if (command == NULL || usage == NULL)
+        return false;
+
+    *usage = (memory_usage_s){0};
+    memory_usage_command_(command, NULL, 0, usage);
+    return true;
+}
+
+const char* memory_usage_category_name(memory_usage_category_e category)
+{
+    if ((size_t)category >= MAX_MEMORY_USAGE_CATEGORY_COUNT)
+        return NULL;
+
+    return memory_usage_category_names_[category];
+}
+
+void memory_usage_dump(FILE* stream, const memory_usage_s* usage)
+{
+    if (stream == NULL || usage == NULL)
+        return;
+
+    for (size_t i = 0; i < MAX_MEMORY_USAGE_CATEGORY_COUNT; ++i)
+        fprintf(stream, "%s %zu\n", memory_usage_category_names_[i], usage->bytes[i]);
+
+    fprintf(stream, "total %zu\n", usage->total);
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+void memory_usage_add_(memory_usage_s* usage, memory_usage_category_e category, size_t bytes)
+{
+    usage->bytes[category] += bytes;
+    usage->total += bytes;
+}
+
+size_t memory_usage_string_(const char* string)
+{
+    return string != NULL ? strlen(string) + 1 : 0;
+}
+
+void memory_usage_notation_(const notation_s* notation, memory_usage_s* usage)
+{
+    if (notation == NULL)
+        return;
+
+    // interning keeps the alias array, but moves the strings themselves into the string pool
+    if (notation->aliases != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_ALIASES, sizeof(char*) * notation->alias_count);
+
+    if (notation->is_interned || notation->is_borrowed)
+        return;
+
+    memory_usage_add_(usage, MEMORY_USAGE_NAMES, memory_usage_string_(notation->main_name));
+    memory_usage_add_(usage, MEMORY_USAGE_DESCRIPTIONS, memory_usage_string_(notation->description));
+    for (size_t i = 0; i < notation->alias_count && notation->aliases != NULL; ++i)
+        memory_usage_add_(usage, MEMORY_USAGE_ALIASES, memory_usage_string_(notation->aliases[i]));
+}
+
+void memory_usage_defaults_(const option_s* option, memory_usage_s* usage)
+{
+    // only the choices and a custom default are copied by a borrowing option
+    bool is_copied = !option->is_borrowed;
+    switch (option->type)
+    {
+    case OPTION_TYPE_STRING:
+        if (is_copied)
+            memory_usage_add_(usage, MEMORY_USAGE_DEFAULTS, memory_usage_string_(option->default_value.string_value));
+        break;
+
+    case OPTION_TYPE_MULTI_STRING:
+    {
+        if (option->default_value.multi_string_value == NULL || !is_copied)
+            break;
+
+        size_t item_count = 0;
+        for (; option->default_value.multi_string_value[item_count] != NULL; ++item_count)
+            memory_usage_add_(usage, MEMORY_USAGE_DEFAULTS, memory_usage_string_(option->default_value.multi_string_value[item_count]));
+
+        memory_usage_add_(usage, MEMORY_USAGE_DEFAULTS, sizeof(char*) * (item_count + 1));
+        break;
+    }
+
+    case OPTION_TYPE_CHOICE:
+        if (option->choices == NULL)
+            break;
+
+        // the structure, names, slots, displacements and strings of the choices share one allocation
+        memory_usage_add_(usage, MEMORY_USAGE_DEFAULTS, sizeof(option_choices_s) +
+                                                        sizeof(char*) * option->choices->count +
+                                                        sizeof(uint32_t) * option->choices->slot_count +
+                                                        sizeof(uint32_t) * option->choices->bucket_count);
+        for (size_t i = 0; i < option->choices->count; ++i)
+            memory_usage_add_(usage, MEMORY_USAGE_DEFAULTS, memory_usage_string_(option->choices->names[i]));
+        break;
+
+    case OPTION_TYPE_CUSTOM:
+        if (option->default_value.custom_value != NULL && option->custom_type != NULL)
+            memory_usage_add_(usage, MEMORY_USAGE_DEFAULTS, option->custom_type->value_size);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void memory_usage_option_(const option_s* option, bool is_loaded, bool count_shared, memory_usage_s* usage)
+{
+    if (option->set_value != NULL)
+    {
+        // the string types hold a growable array of pointers
+        size_t value_size = option_value_size(option->type, option->custom_type);
+        if (option->type == OPTION_TYPE_STRING || option->type == OPTION_TYPE_MULTI_STRING)
+            value_size *= option->value_capacity;
+
+        memory_usage_add_(usage, MEMORY_USAGE_VALUES, value_size);
+    }
+
+    if (option->parsed_arguments.parameters != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_PARAMETERS, sizeof(char*) * option->parsed_arguments.parameter_count);
+
+    // everything shared between the copies of a loaded option lives in the image or in the block of the tree
+    if (is_loaded || !count_shared)
+        return;
+
+    if (option->shared_notation.counter_ != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_SHARED_VALUES, sizeof(int64_t) + option->shared_notation.value_mem_size_);
+
+    memory_usage_notation_(shared_value_read_const(&option->shared_notation), usage);
+    memory_usage_defaults_(option, usage);
+}
+
+void memory_usage_positional_(const positional_s* positional, memory_usage_s* usage)
+{
+    if (!positional->is_borrowed)
+        memory_usage_add_(usage, MEMORY_USAGE_NAMES, memory_usage_string_(positional->name));
+
+    if (positional->values == NULL)
+        return;
+
+    memory_usage_add_(usage, MEMORY_USAGE_VALUES, option_value_size(positional->type, NULL) * positional->value_capacity);
+}
+
+void memory_usage_command_(const command_s* command, const command_s* previous_commands, size_t previous_count, memory_usage_s* usage)
+{
+    if (!command->is_compacted)
+    {
+        memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, sizeof(option_s) * command->option_capacity);
+        if (command->required_options != NULL)
+            memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, sizeof(uint64_t) * command->option_word_count * 3);
+    }
+
+    if (!command->is_loaded)
+    {
+        memory_usage_notation_(&command->notation, usage);
+        if (command->option_index != NULL)
+            memory_usage_add_(usage, MEMORY_USAGE_INDICES, sizeof(uint32_t) * command->option_index_capacity * NOTATION_INDEX_LANES);
+    }
+
+    if (command->parsed_arguments.parameters != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_PARAMETERS, sizeof(char*) * command->parsed_arguments.argv_count);
+
+    memory_usage_add_(usage, MEMORY_USAGE_DIAGNOSTICS, sizeof(diagnostic_s) * command->diagnostics.capacity);
+
+    // positionals are never compacted, nor part of a schema image
+    if (command->positionals != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, sizeof(positional_s) * command->positional_capacity);
+    for (size_t i = 0; i < command->positional_count; ++i)
+        memory_usage_positional_(&command->positionals[i], usage);
+
+    if (command->constraints != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, sizeof(constraint_s) * command->constraint_capacity);
+    if (command->constraint_masks != NULL)
+        memory_usage_add_(usage, MEMORY_USAGE_STRUCTURES, sizeof(uint64_t) * command->option_word_count * command->constraint_count);
+    for (size_t i = 0; i < command->constraint_count; ++i)
+        memory_usage_add_(usage, MEMORY_USAGE_INDICES, (sizeof(size_t) + sizeof(char*)) * command->constraints[i].option_count);
+
+    for (size_t i = 0; i < command->option_count; ++i)
+    {
+        const option_s* option = &command->options[i];
+        bool count_shared = !memory_usage_is_shared_earlier_(option, previous_commands, previous_count);
+        memory_usage_option_(option, command->is_loaded, count_shared, usage);
+    }
+}
+
+bool memory_usage_is_shared_earlier_(const option_s* option, const command_s* previous_commands, size_t previous_count)
+{
+    if (option->shared_notation.counter_ == NULL || shared_value_use_count(&option->shared_notation) < 2)
+        return false;
+
+    // only options with more than one user get here, so the quadratic search stays small in practice
+    for (size_t i = 0; i < previous_count; ++i)
+    {
+        for (size_t j = 0; j < previous_commands[i].option_count; ++j)
+        {
+            if (previous_commands[i].options[j].shared_notation.counter_ == option->shared_notation.counter_)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// END LOCAL IMPLEMENTATIONS //
@@ -1,23 +1,31 @@
 #include "notation.h"
 
+#include "diagnostics.h"
+#include "parse_stats.h"
+
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
 
+// LOCAL DEFINITIONS //
+
+static bool notation_name_matches_(const notation_s* notation, const char* name, const char* value, size_t value_length);
+static bool notation_measure_string_(const char* string, string_set_s* seen, size_t* pool_size);
+static char* notation_intern_string_(char* string, bool is_owned, string_set_s* pooled, char* pool, size_t* pool_used);
+
+// END LOCAL DEFINITIONS //
+
 bool notation_init(notation_s* notation, const char* main_name, size_t alias_n, va_list aliases)
 {
     if (notation == NULL || main_name == NULL)
         return false;
 
     if (!notation_is_valid_flag(main_name))
-    {
-        fprintf(stderr, "`%s` is not a valid flag name, flags should begin with `-`\n", main_name);
         return false;
-    }
 
     notation->description = NULL;
+    notation->is_interned = false;
 
-    notation->main_name = strdup(main_name);
+    notation->main_name = notation->is_borrowed ? (char*)main_name : strdup(main_name);
     if (notation->main_name == NULL)
         return false;
 
@@ -25,13 +33,16 @@ bool notation_init(notation_s* notation, const char* main_name, size_t alias_n,
     {
         notation->aliases = NULL;
         notation->alias_count = 0;
+        notation_store_short_names(notation);
         return true;
     }
 
     notation->aliases = malloc(sizeof(char*) * alias_n);
     if (notation->aliases == NULL)
     {
-        free(notation->main_name);
+        if (!notation->is_borrowed)
+            free(notation->main_name);
+        notation->main_name = NULL;
         notation->alias_count = 0;
         return false;
     }
@@ -42,14 +53,15 @@ bool notation_init(notation_s* notation, const char* main_name, size_t alias_n,
         const char* val = va_arg(aliases, char*);
         if (notation_is_valid_flag(val))
         {
-            notation->aliases[i] = strdup(val);
+            notation->aliases[i] = notation->is_borrowed ? (char*)val : strdup(val);
             continue;
         }
 
-        fprintf(stderr, "`%s` is not a valid flag name, flags should begin with `-`\n", val);
+        // reported through `DIAGNOSTIC_INVALID_ALIAS` when the owning command or command-tree is frozen
         notation->aliases[i] = NULL;
     }
 
+    notation_store_short_names(notation);
 
     return true;
 }
@@ -59,7 +71,7 @@ bool notation_set_description(notation_s* notation, const char* description)
     if (notation == NULL || description == NULL)
         return false;
 
-    notation->description = strdup(description);
+    notation->description = notation->is_borrowed ? (char*)description : strdup(description);
     return notation->description != NULL;
 }
 
@@ -68,10 +80,19 @@ void notation_clean(notation_s* notation)
     if (notation == NULL || notation->main_name == NULL)
         return;
 
+    // the string pool owning interned strings is free'd by the command-tree, borrowed strings by nobody
+    if (notation->is_interned || notation->is_borrowed)
+    {
+        free(notation->aliases);
+        *notation = (notation_s){0};
+        return;
+    }
+
     free(notation->description);
     notation->description = NULL;
     free(notation->main_name);
     notation->main_name = NULL;
+    notation->short_name_count = 0;
 
     if (notation->aliases == NULL)
     {
@@ -97,7 +118,21 @@ bool notation_has_value(const notation_s* notation, const char* value)
     if (notation == NULL || notation->main_name == NULL)
         return false;
 
-    if (strcmp(value, notation->main_name) == 0)
+    // names that fit inline are compared without leaving the notation, a longer value never matches them
+    if (notation->short_name_count > 0)
+    {
+        for (size_t i = 0; i < notation->short_name_count; ++i)
+        {
+            PARSE_STATS_COUNT(PARSE_STATS_STRING_COMPARES, 1);
+            if (strncmp(notation->short_names[i], value, NOTATION_SHORT_NAME_SIZE) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    size_t value_length = notation->is_interned ? strlen(value) : 0;
+    if (notation_name_matches_(notation, notation->main_name, value, value_length))
         return true;
 
     if (notation->aliases == NULL || notation->alias_count == 0)
@@ -105,13 +140,39 @@ bool notation_has_value(const notation_s* notation, const char* value)
 
     for (size_t i = 0; i < notation->alias_count; ++i)
     {
-        if (strcmp(notation->aliases[i], value) == 0)
+        if (notation_name_matches_(notation, notation->aliases[i], value, value_length))
             return true;
     }
 
     return false;
 }
 
+void notation_store_short_names(notation_s* notation)
+{
+    if (notation == NULL)
+        return;
+
+    notation->short_name_count = 0;
+    memset(notation->short_names, 0, sizeof(notation->short_names));
+    if (notation->main_name == NULL || notation->alias_count >= NOTATION_SHORT_NAME_COUNT ||
+        (notation->alias_count > 0 && notation->aliases == NULL))
+        return;
+
+    for (size_t i = 0; i <= notation->alias_count; ++i)
+    {
+        const char* name = i == 0 ? notation->main_name : notation->aliases[i - 1];
+        if (name == NULL || strlen(name) >= NOTATION_SHORT_NAME_SIZE)
+        {
+            memset(notation->short_names, 0, sizeof(notation->short_names));
+            return;
+        }
+
+        strcpy(notation->short_names[i], name);
+    }
+
+    notation->short_name_count = (unsigned char)(notation->alias_count + 1);
+}
+
 bool notation_is_valid_flag(const char* value)
 {
     if (strlen(value) <= 0)
@@ -119,3 +180,185 @@ bool notation_is_valid_flag(const char* value)
 
     return value[0] == '-';
 }
+
+bool notation_register_names(const notation_s* notation, string_set_s* names, diagnostics_s* diagnostics)
+{
+    if (names == NULL)
+        return false;
+
+    if (notation == NULL || notation->main_name == NULL)
+    {
+        diagnostics_push(diagnostics, DIAGNOSTIC_MISSING_NAME, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    bool is_valid = true;
+    bool was_present = false;
+
+    if (!string_set_insert(names, notation->main_name, strlen(notation->main_name), &was_present))
+    {
+        diagnostics_push(diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+        return false;
+    }
+
+    if (was_present)
+    {
+        diagnostics_push(diagnostics, DIAGNOSTIC_DUPLICATE_FLAG, DIAGNOSTIC_NO_ARGV_INDEX, notation->main_name, MAX_OPTION_TYPE_COUNT);
+        is_valid = false;
+    }
+
+    for (size_t i = 0; i < notation->alias_count; ++i)
+    {
+        const char* alias = notation->aliases[i];
+        if (alias == NULL)
+        {
+            diagnostics_push(diagnostics, DIAGNOSTIC_INVALID_ALIAS, DIAGNOSTIC_NO_ARGV_INDEX, notation->main_name, MAX_OPTION_TYPE_COUNT);
+            is_valid = false;
+            continue;
+        }
+
+        if (!string_set_insert(names, alias, strlen(alias), &was_present))
+        {
+            diagnostics_push(diagnostics, DIAGNOSTIC_OUT_OF_MEMORY, DIAGNOSTIC_NO_ARGV_INDEX, NULL, MAX_OPTION_TYPE_COUNT);
+            return false;
+        }
+
+        if (was_present)
+        {
+            diagnostics_push(diagnostics, DIAGNOSTIC_DUPLICATE_FLAG, DIAGNOSTIC_NO_ARGV_INDEX, alias, MAX_OPTION_TYPE_COUNT);
+            is_valid = false;
+        }
+    }
+
+    return is_valid;
+}
+
+size_t notation_index_capacity(size_t name_count)
+{
+    size_t capacity = 8;
+    while (capacity < name_count * 2)
+        capacity *= 2;
+
+    return capacity;
+}
+
+void notation_index_insert(uint32_t* slots, size_t capacity, const notation_s* notation, uint32_t entry)
+{
+    if (slots == NULL || capacity == 0 || notation == NULL || notation->main_name == NULL)
+        return;
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i <= notation->alias_count; ++i)
+    {
+        const char* name = i == 0 ? notation->main_name : notation->aliases[i - 1];
+        if (name == NULL)
+            continue;
+
+        size_t length = strlen(name);
+        uint64_t hash = string_set_hash(name, length);
+        size_t slot = (size_t)hash & mask;
+        while (slots[slot] != 0)
+            slot = (slot + 1) & mask;
+
+        slots[slot] = entry;
+        slots[capacity + slot] = notation_index_tag(hash);
+        slots[capacity * 2 + slot] = (uint32_t)length;
+    }
+}
+
+uint64_t notation_hash_flag(const char* flag)
+{
+    return string_set_hash(flag, strlen(flag));
+}
+
+uint32_t notation_index_tag(uint64_t hash)
+{
+    // the low bits already pick the slot, so the high bits tell the names within a cluster apart
+    return (uint32_t)(hash >> 32);
+}
+
+bool notation_measure_pooled(const notation_s* notation, string_set_s* seen, size_t* pool_size)
+{
+    if (notation == NULL || notation->is_interned)
+        return true;
+
+    bool success = notation_measure_string_(notation->main_name, seen, pool_size) &&
+                   notation_measure_string_(notation->description, seen, pool_size);
+
+    for (size_t i = 0; i < notation->alias_count && success; ++i)
+        success = notation_measure_string_(notation->aliases[i], seen, pool_size);
+
+    return success;
+}
+
+void notation_intern(notation_s* notation, string_set_s* pooled, char* pool, size_t* pool_used)
+{
+    if (notation == NULL || notation->is_interned || notation->main_name == NULL)
+        return;
+
+    bool is_owned = !notation->is_borrowed;
+    notation->main_name = notation_intern_string_(notation->main_name, is_owned, pooled, pool, pool_used);
+    notation->description = notation_intern_string_(notation->description, is_owned, pooled, pool, pool_used);
+    for (size_t i = 0; i < notation->alias_count; ++i)
+        notation->aliases[i] = notation_intern_string_(notation->aliases[i], is_owned, pooled, pool, pool_used);
+
+    notation->is_interned = true;
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+bool notation_name_matches_(const notation_s* notation, const char* name, const char* value, size_t value_length)
+{
+    if (name == NULL)
+        return false;
+
+    PARSE_STATS_COUNT(PARSE_STATS_STRING_COMPARES, 1);
+    if (!notation->is_interned)
+        return strcmp(name, value) == 0;
+
+    // pooled strings carry their length, so most mismatches never touch the characters
+    uint32_t name_length = 0;
+    memcpy(&name_length, name - NOTATION_POOL_PREFIX_SIZE, sizeof(uint32_t));
+    return name_length == value_length && memcmp(name, value, value_length) == 0;
+}
+
+bool notation_measure_string_(const char* string, string_set_s* seen, size_t* pool_size)
+{
+    if (string == NULL)
+        return true;
+
+    size_t length = strlen(string);
+    bool was_present = false;
+    if (!string_set_insert(seen, string, length, &was_present))
+        return false;
+
+    if (!was_present)
+        *pool_size += NOTATION_POOL_PREFIX_SIZE + length + 1;
+
+    return true;
+}
+
+char* notation_intern_string_(char* string, bool is_owned, string_set_s* pooled, char* pool, size_t* pool_used)
+{
+    if (string == NULL)
+        return NULL;
+
+    size_t length = strlen(string);
+    char* interned = (char*)string_set_find(pooled, string, length);
+    if (interned == NULL)
+    {
+        uint32_t prefix = (uint32_t)length;
+        memcpy(pool + *pool_used, &prefix, sizeof(uint32_t));
+        interned = pool + *pool_used + NOTATION_POOL_PREFIX_SIZE;
+        memcpy(interned, string, length + 1);
+        *pool_used += NOTATION_POOL_PREFIX_SIZE + length + 1;
+
+        string_set_insert(pooled, interned, length, NULL);
+    }
+
+    if (is_owned)
+        free(string);
+    return interned;
+}
+
+// END LOCAL IMPLEMENTATIONS //
@@ -2,18 +2,31 @@
 
 #include "notation.h"
 #include "arguments.h"
+#include "parse_stats.h"
+#include "extra/dynamic_array.h"
+#include "extra/perfect_hash.h"
+#include "extra/string_set.h"
+#include "extra/unit_suffix.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stdint.h>
 
 // LOCAL FUNCTION DEFINITIONS //
 
+#define OPTION_CHOICES_MAX_GROW_ATTEMPTS 8
+
+
+static bool init_option_common_(option_s* option);
+static bool init_option_(option_s* option, bool is_required, option_type_e option_type, void* default_value, bool is_borrowed);
 static bool init_option_default__bool_(option_s* option, void* default_value);
 static bool init_option_default__int_(option_s* option, void* default_value);
 static bool init_option_default__float_(option_s* option, void* default_value);
 static bool init_option_default__string_(option_s* option, void* default_value);
 static bool init_option_default__multi_string_(option_s* option, void* default_value);
+static bool init_option_default__uint64_(option_s* option, void* default_value);
+static bool init_option_default__custom_(option_s* option, const char* default_text);
 
 static const char* parse_read_first_val_(option_s* option, bool flag_can_follow, const char* default_present, int* consumed);
 static int parse_option__bool_(option_s* option);
@@ -21,55 +34,50 @@ static int parse_option__int_(option_s* option);
 static int parse_option__float_(option_s* option);
 static int parse_option__string_(option_s* option);
 static int parse_option__multi_string_(option_s* option);
+static int parse_option__choice_(option_s* option);
+static int parse_option__custom_(option_s* option);
+static int parse_option__units_(option_s* option, bool (*parse_units)(const char*, size_t, uint64_t*));
+static bool parse_append_values_(option_s* option, const char* const* values, size_t value_count, bool null_terminate);
+
+static bool set_option__strings_(option_s* option, const void* value);
 
 static void clean_option__string_(option_s* option);
 static void clean_option__multi_string_(option_s* option);
+static void clean_custom_value_(const option_type_vtable_s* custom_type, void* value);
 
 static void notation_generic_cleaner_(void* notation);
 
+static option_choices_s* choices_create_(const char* const* names, size_t count);
+static int choices_find_(const option_choices_s* choices, const char* value);
+
 // END LOCAL FUNCTION DEFINITIONS //
 
 bool option_init(option_s* option, bool is_required, option_type_e option_type, void* default_value)
 {
-    if (option == NULL || option_type >= MAX_OPTION_TYPE_COUNT)
-        return false;
+    return init_option_(option, is_required, option_type, default_value, false);
+}
 
-    if (!shared_value_init_unused(&option->shared_notation, sizeof(notation_s)))
-    {
-        shared_value_clean(&option->shared_notation);
-        return false;
-    }
+bool option_init_borrowed(option_s* option, bool is_required, option_type_e option_type, void* default_value)
+{
+    return init_option_(option, is_required, option_type, default_value, true);
+}
 
-    option->set_value = NULL;
+bool option_init_custom(option_s* option, bool is_required, const option_type_vtable_s* custom_type, const char* default_text)
+{
+    if (option == NULL || custom_type == NULL || custom_type->parse == NULL || custom_type->value_size == 0)
+        return false;
 
-    bool init_success = false;
-    switch(option_type)
-    {
-    case OPTION_TYPE_BOOL:
-        init_success = init_option_default__bool_(option, default_value);
-    break;
-    case OPTION_TYPE_INT:
-        init_success = init_option_default__int_(option, default_value);
-    break;
-    case OPTION_TYPE_FLOAT:
-        init_success = init_option_default__float_(option, default_value);
-    break;
-    case OPTION_TYPE_STRING:
-        init_success = init_option_default__string_(option, default_value);
-    break;
-    case OPTION_TYPE_MULTI_STRING:
-        init_success = init_option_default__multi_string_(option, default_value);
-    default:
-    break;
-    }
+    if (!init_option_common_(option))
+        return false;
 
-    if (!init_success)
+    option->custom_type = custom_type;
+    if (!init_option_default__custom_(option, default_text))
     {
         shared_value_clean(&option->shared_notation);
         return false;
     }
 
-    option->type = option_type;
+    option->type = OPTION_TYPE_CUSTOM;
     option->is_required = is_required;
     return true;
 }
@@ -97,6 +105,124 @@ bool option_set_description(option_s* option, const char* description)
     return notation_set_description((notation_s*)shared_value_read(&option->shared_notation), description);
 }
 
+bool option_set_repeat_policy(option_s* option, option_repeat_policy_e repeat_policy)
+{
+    if (option == NULL || repeat_policy >= MAX_OPTION_REPEAT_POLICY_COUNT)
+        return false;
+
+    if (repeat_policy == OPTION_REPEAT_COUNT && option->type != OPTION_TYPE_BOOL)
+        return false;
+
+    if (repeat_policy == OPTION_REPEAT_ACCUMULATE &&
+        option->type != OPTION_TYPE_STRING &&
+        option->type != OPTION_TYPE_MULTI_STRING)
+        return false;
+
+    option->repeat_policy = repeat_policy;
+    return true;
+}
+
+bool option_set_stream(option_s* option, char delimiter, option_stream_f callback, void* context)
+{
+    if (option == NULL || option->type != OPTION_TYPE_MULTI_STRING || callback == NULL)
+        return false;
+
+    if (delimiter != '\0' && delimiter != '\n')
+        return false;
+
+    option->stream_callback = callback;
+    option->stream_context = context;
+    option->stream_delimiter = delimiter;
+    return true;
+}
+
+bool option_is_stream_marker(const option_s* option, const char* argument)
+{
+    return option != NULL && argument != NULL && option->stream_callback != NULL && strcmp(argument, OPTION_STREAM_MARKER) == 0;
+}
+
+size_t option_count_values(const option_s* option, size_t argument_count, const char* const* arguments)
+{
+    if (option == NULL || argument_count == 0)
+        return 0;
+
+    switch (option->type)
+    {
+    case OPTION_TYPE_BOOL:
+        return 0;
+
+    // every value up to the next flag, which the stream marker only looks like
+    case OPTION_TYPE_MULTI_STRING:
+    {
+        size_t count = 0;
+        while (count < argument_count &&
+               (!notation_is_valid_flag(arguments[count]) || option_is_stream_marker(option, arguments[count])))
+            count++;
+
+        return count;
+    }
+
+    default:
+        return 1;
+    }
+}
+
+size_t option_value_size(option_type_e type, const option_type_vtable_s* custom_type)
+{
+    switch (type)
+    {
+    case OPTION_TYPE_BOOL:         return sizeof(bool);
+    case OPTION_TYPE_INT:          return sizeof(int);
+    case OPTION_TYPE_FLOAT:        return sizeof(float);
+    case OPTION_TYPE_CHOICE:       return sizeof(int);
+    case OPTION_TYPE_SIZE:         return sizeof(uint64_t);
+    case OPTION_TYPE_DURATION:     return sizeof(uint64_t);
+    case OPTION_TYPE_STRING:       return sizeof(char*);
+    case OPTION_TYPE_MULTI_STRING: return sizeof(char*);
+    case OPTION_TYPE_CUSTOM:       return custom_type != NULL ? custom_type->value_size : 0;
+
+    default:
+        return 0;
+    }
+}
+
+bool option_set_choices(option_s* option, size_t choice_n, ...)
+{
+    if (option == NULL || option->type != OPTION_TYPE_CHOICE || choice_n == 0 || choice_n >= UINT32_MAX)
+        return false;
+
+    const char** names = malloc(sizeof(char*) * choice_n);
+    if (names == NULL)
+        return false;
+
+    va_list choice_args;
+    va_start(choice_args, choice_n);
+    for (size_t i = 0; i < choice_n; ++i)
+        names[i] = va_arg(choice_args, const char*);
+    va_end(choice_args);
+
+    bool is_set = option_set_choice_array(option, choice_n, names);
+    free(names);
+    return is_set;
+}
+
+bool option_set_choice_array(option_s* option, size_t choice_count, const char* const* choices)
+{
+    if (option == NULL || choices == NULL || option->type != OPTION_TYPE_CHOICE || choice_count == 0 || choice_count >= UINT32_MAX)
+        return false;
+
+    if (option->default_value.int_value < 0 || (size_t)option->default_value.int_value >= choice_count)
+        return false;
+
+    option_choices_s* created_choices = choices_create_(choices, choice_count);
+    if (created_choices == NULL)
+        return false;
+
+    free(option->choices);
+    option->choices = created_choices;
+    return true;
+}
+
 void option_clean(option_s* option)
 {
     if (option == NULL)
@@ -113,23 +239,97 @@ void option_clean(option_s* option)
         case OPTION_TYPE_MULTI_STRING:
             clean_option__multi_string_(option);
         break;
+        case OPTION_TYPE_CHOICE:
+            free(option->choices);
+            option->choices = NULL;
+        break;
+        case OPTION_TYPE_CUSTOM:
+            clean_custom_value_(option->custom_type, option->default_value.custom_value);
+            option->default_value.custom_value = NULL;
+        break;
 
         default:
         break;
         }
     }
 
+    option_reset(option);
+    shared_value_clean_ex(&option->shared_notation, notation_generic_cleaner_);
+}
+
+void option_reset(option_s* option)
+{
+    if (option == NULL)
+        return;
+
     arguments_clean(&option->parsed_arguments);
+    if (option->type == OPTION_TYPE_CUSTOM && option->set_value != NULL)
+    {
+        clean_custom_value_(option->custom_type, option->set_value);
+        option->set_value = NULL;
+    }
     free(option->set_value);
-    shared_value_clean_ex(&option->shared_notation, notation_generic_cleaner_);
+    option->set_value = NULL;
+    option->value_count = 0;
+    option->value_capacity = 0;
+    option->occurrence_count = 0;
+    option->is_overridden = false;
+}
+
+bool option_set_value(option_s* option, const void* value)
+{
+    if (option == NULL || value == NULL)
+        return false;
+
+    // the strings are referenced like the parsed ones, so they only replace the stored pointers
+    if (option->type == OPTION_TYPE_STRING || option->type == OPTION_TYPE_MULTI_STRING)
+        return set_option__strings_(option, value);
+
+    // without its vtable a custom type has no size, which keeps it unsupported
+    size_t value_size = option_value_size(option->type, NULL);
+    if (value_size == 0)
+        return false;
+
+    if (option->type == OPTION_TYPE_CHOICE &&
+        (option->choices == NULL || *(const int*)value < 0 || (size_t)*(const int*)value >= option->choices->count))
+        return false;
+
+    if (option->set_value == NULL)
+        option->set_value = malloc(value_size);
+    if (option->set_value == NULL)
+        return false;
+
+    memcpy(option->set_value, value, value_size);
+    option->is_overridden = true;
+    if (option->occurrence_count == 0)
+        option->occurrence_count = 1;
+
+    return true;
 }
 
 int option_parse(option_s* option)
 {
-    if (option == NULL || option->set_value != NULL)
+    if (option == NULL)
         return 0;
 
+    if (option->set_value != NULL)
+    {
+        switch (option->repeat_policy)
+        {
+        case OPTION_REPEAT_FIRST_WINS:
+        case OPTION_REPEAT_COUNT:
+            option->occurrence_count++;
+            return (int)option_count_values(option, option->parsed_arguments.argv_count,
+                                            option->parsed_arguments.argv_arguments);
+
+        // the parse functions override or append to the already set value
+        default:
+        break;
+        }
+    }
+
     int arguments_consumed = 0;
+    PARSE_STATS_BEGIN(NULL, PARSE_STATS_PHASE_CONVERSION);
 
     switch(option->type)
     {
@@ -148,11 +348,27 @@ int option_parse(option_s* option)
     case OPTION_TYPE_MULTI_STRING:
         arguments_consumed = parse_option__multi_string_(option);
     break;
+    case OPTION_TYPE_CHOICE:
+        arguments_consumed = parse_option__choice_(option);
+    break;
+    case OPTION_TYPE_SIZE:
+        arguments_consumed = parse_option__units_(option, unit_suffix_parse_size);
+    break;
+    case OPTION_TYPE_DURATION:
+        arguments_consumed = parse_option__units_(option, unit_suffix_parse_duration);
+    break;
+    case OPTION_TYPE_CUSTOM:
+        arguments_consumed = parse_option__custom_(option);
+    break;
 
     default:
     break;
     }
 
+    PARSE_STATS_END();
+    if (arguments_consumed >= 0)
+        option->occurrence_count++;
+
     return arguments_consumed;
 }
 
@@ -240,6 +456,11 @@ const char* option_read_string(const option_s* option)
 
     const char** string_value = NULL;
     option_read_value(option, (void**)&string_value);
+
+    // the latest occurrence is the one that counts when the values were accumulated
+    if (option->set_value != NULL && option->value_count > 0)
+        return string_value[option->value_count - 1];
+
     return *string_value;
 }
 
@@ -257,6 +478,13 @@ const char** option_read_multi_string(const option_s* option, size_t* count)
     if (option->set_value == NULL)
         string_array = (const char**)*string_array;
 
+    if (string_array == NULL)
+    {
+        if (count != NULL)
+            *count = 0;
+        return NULL;
+    }
+
     // Since the string-array is also NULL-terminated, we can calulate it's length by looping
     if (count != NULL)
         for (*count = 0; string_array[*count] != NULL; ++(*count)) {};
@@ -264,8 +492,169 @@ const char** option_read_multi_string(const option_s* option, size_t* count)
     return string_array;
 }
 
+const char** option_read_string_list(const option_s* option, size_t* count)
+{
+    if (option == NULL)
+        return NULL;
+
+    if (option->type == OPTION_TYPE_MULTI_STRING)
+        return option_read_multi_string(option, count);
+
+    if (option->type != OPTION_TYPE_STRING || option->repeat_policy != OPTION_REPEAT_ACCUMULATE)
+        return NULL;
+
+    if (option->set_value == NULL)
+    {
+        if (count != NULL)
+            *count = option->default_value.string_value != NULL;
+
+        return option->default_value.string_value != NULL ? (const char**)&option->default_value.string_value : NULL;
+    }
+
+    if (count != NULL)
+        *count = option->value_count;
+
+    return (const char**)option->set_value;
+}
+
+size_t option_read_count(const option_s* option)
+{
+    if (option == NULL)
+        return 0;
+
+    return option->occurrence_count;
+}
+
+int option_read_choice(const option_s* option)
+{
+    if (option == NULL || option->type != OPTION_TYPE_CHOICE)
+        return -1;
+
+    int* choice_value = NULL;
+    option_read_value(option, (void**)&choice_value);
+    return *choice_value;
+}
+
+const char* option_read_choice_name(const option_s* option)
+{
+    int choice = option_read_choice(option);
+    if (choice < 0 || option->choices == NULL || (size_t)choice >= option->choices->count)
+        return NULL;
+
+    return option->choices->names[choice];
+}
+
+uint64_t option_read_size(const option_s* option)
+{
+    if (option == NULL || option->type != OPTION_TYPE_SIZE)
+        return 0;
+
+    uint64_t* size_value = NULL;
+    option_read_value(option, (void**)&size_value);
+    return *size_value;
+}
+
+uint64_t option_read_duration(const option_s* option)
+{
+    if (option == NULL || option->type != OPTION_TYPE_DURATION)
+        return 0;
+
+    uint64_t* duration_value = NULL;
+    option_read_value(option, (void**)&duration_value);
+    return *duration_value;
+}
+
+const void* option_read_custom(const option_s* option, const option_type_vtable_s* custom_type)
+{
+    // the vtable identifies the type, so a value is never read as another type than it was converted to
+    if (option == NULL || option->type != OPTION_TYPE_CUSTOM || custom_type == NULL || option->custom_type != custom_type)
+        return NULL;
+
+    if (option->set_value != NULL)
+        return option->set_value;
+
+    return option->default_value.custom_value;
+}
+
 // LOCAL FUNCTION IMPLEMENTATIONS //
 
+bool init_option_common_(option_s* option)
+{
+    if (!shared_value_init_unused(&option->shared_notation, sizeof(notation_s)))
+    {
+        shared_value_clean(&option->shared_notation);
+        return false;
+    }
+
+    option->set_value = NULL;
+    option->value_count = 0;
+    option->value_capacity = 0;
+    option->occurrence_count = 0;
+    option->is_overridden = false;
+    option->repeat_policy = OPTION_REPEAT_FIRST_WINS;
+    option->is_borrowed = false;
+    option->parsed_arguments = (arguments_s){0};
+    option->choices = NULL;
+    option->custom_type = NULL;
+    option->stream_callback = NULL;
+    option->stream_context = NULL;
+    option->stream_delimiter = '\0';
+    return true;
+}
+
+bool init_option_(option_s* option, bool is_required, option_type_e option_type, void* default_value, bool is_borrowed)
+{
+    if (option == NULL || option_type >= MAX_OPTION_TYPE_COUNT)
+        return false;
+
+    if (!init_option_common_(option))
+        return false;
+
+    // the notation is zeroed by its shared value, so it only has to be told to borrow
+    option->is_borrowed = is_borrowed;
+    ((notation_s*)shared_value_read(&option->shared_notation))->is_borrowed = is_borrowed;
+
+    bool init_success = false;
+    switch(option_type)
+    {
+    case OPTION_TYPE_BOOL:
+        init_success = init_option_default__bool_(option, default_value);
+    break;
+    case OPTION_TYPE_INT:
+        init_success = init_option_default__int_(option, default_value);
+    break;
+    case OPTION_TYPE_FLOAT:
+        init_success = init_option_default__float_(option, default_value);
+    break;
+    case OPTION_TYPE_STRING:
+        init_success = init_option_default__string_(option, default_value);
+    break;
+    case OPTION_TYPE_MULTI_STRING:
+        init_success = init_option_default__multi_string_(option, default_value);
+    break;
+    case OPTION_TYPE_CHOICE:
+        init_success = init_option_default__int_(option, default_value);
+    break;
+    case OPTION_TYPE_SIZE:
+    case OPTION_TYPE_DURATION:
+        init_success = init_option_default__uint64_(option, default_value);
+    break;
+
+    default:
+    break;
+    }
+
+    if (!init_success)
+    {
+        shared_value_clean(&option->shared_notation);
+        return false;
+    }
+
+    option->type = option_type;
+    option->is_required = is_required;
+    return true;
+}
+
 bool init_option_default__bool_(option_s* option, void* default_value)
 {
     if (default_value != NULL)
@@ -300,7 +689,7 @@ bool init_option_default__string_(option_s* option, void* default_value)
 {
     if (default_value != NULL)
     {
-        option->default_value.string_value = strdup((char*)default_value);
+        option->default_value.string_value = option->is_borrowed ? (char*)default_value : strdup((char*)default_value);
         if (option->default_value.string_value == NULL)
             return false;
     }
@@ -325,6 +714,13 @@ bool init_option_default__multi_string_(option_s* option, void* default_value)
     if (item_count == 0)
         return true;
 
+    // a borrowed array is already NULL-terminated
+    if (option->is_borrowed)
+    {
+        option->default_value.multi_string_value = default_value;
+        return true;
+    }
+
     // encode it such that the ending entry is always a NULL value
     // so it becomes a NULL terminated array
     option->default_value.multi_string_value = malloc(sizeof(char*) * (item_count + 1));
@@ -342,6 +738,40 @@ bool init_option_default__multi_string_(option_s* option, void* default_value)
     return true;
 }
 
+bool init_option_default__uint64_(option_s* option, void* default_value)
+{
+    if (default_value != NULL)
+        option->default_value.size_value = *(uint64_t*)default_value;
+    else
+        option->default_value.size_value = 0;
+
+    return true;
+}
+
+bool init_option_default__custom_(option_s* option, const char* default_text)
+{
+    const option_type_vtable_s* custom_type = option->custom_type;
+    option->default_value.custom_value = calloc(1, custom_type->value_size);
+    if (option->default_value.custom_value == NULL)
+        return false;
+
+    if (default_text == NULL)
+    {
+        if (custom_type->init_default != NULL)
+            custom_type->init_default(option->default_value.custom_value, custom_type->context);
+
+        return true;
+    }
+
+    if (custom_type->parse(default_text, strlen(default_text), option->default_value.custom_value, custom_type->context))
+        return true;
+
+    // a rejected value owns nothing, so only its memory is released
+    free(option->default_value.custom_value);
+    option->default_value.custom_value = NULL;
+    return false;
+}
+
 const char* parse_read_first_val_(option_s* option, bool flag_can_follow, const char* default_present, int* consumed)
 {
     const char* value = NULL;
@@ -352,6 +782,10 @@ const char* parse_read_first_val_(option_s* option, bool flag_can_follow, const
     if (consumes)
     {
         option->parsed_arguments.parameters = malloc(sizeof(char*) * 1);
+        if (option->parsed_arguments.parameters == NULL)
+            return NULL;
+
+        PARSE_STATS_ALLOCATION(sizeof(char*));
         option->parsed_arguments.parameter_count = 1;
 
         value = *option->parsed_arguments.argv_arguments;
@@ -374,9 +808,14 @@ int parse_option__bool_(option_s* option)
     if (option == NULL)
         return 0;
 
-    option->set_value = malloc(sizeof(bool));
     if (option->set_value == NULL)
-        return -1;
+    {
+        option->set_value = malloc(sizeof(bool));
+        if (option->set_value == NULL)
+            return -1;
+
+        PARSE_STATS_ALLOCATION(sizeof(bool));
+    }
 
     *(bool*)option->set_value = true;
     return 0;
@@ -394,9 +833,14 @@ int parse_option__int_(option_s* option)
 
     int int_value = atoi(text_value);
 
-    option->set_value = malloc(sizeof(int));
     if (option->set_value == NULL)
-        return -1;
+    {
+        option->set_value = malloc(sizeof(int));
+        if (option->set_value == NULL)
+            return -1;
+
+        PARSE_STATS_ALLOCATION(sizeof(int));
+    }
 
     *(int*)option->set_value = int_value;
     return consumed_count;
@@ -414,9 +858,14 @@ int parse_option__float_(option_s* option)
 
     float float_value = (float)atof(text_value);
 
-    option->set_value = malloc(sizeof(float));
     if (option->set_value == NULL)
-        return -1;
+    {
+        option->set_value = malloc(sizeof(float));
+        if (option->set_value == NULL)
+            return -1;
+
+        PARSE_STATS_ALLOCATION(sizeof(float));
+    }
 
     *(float*)option->set_value = float_value;
     return consumed_count;
@@ -433,11 +882,9 @@ int parse_option__string_(option_s* option)
     if (consumed_count == 0 || text_value == NULL)
         return -1;
 
-    option->set_value = malloc(sizeof(char*));
-    if (option->set_value == NULL)
+    if (!parse_append_values_(option, &text_value, 1, false))
         return -1;
 
-    *(const char**)option->set_value = text_value;
     return consumed_count;
 }
 
@@ -446,42 +893,175 @@ int parse_option__multi_string_(option_s* option)
     if (option == NULL)
         return 0;
 
+    // the stream marker looks like a flag, but is a value to a streaming option
     int valid_arg_count = 0;
     for (; valid_arg_count < (int)option->parsed_arguments.argv_count &&
-         !notation_is_valid_flag(option->parsed_arguments.argv_arguments[valid_arg_count]);
+         (!notation_is_valid_flag(option->parsed_arguments.argv_arguments[valid_arg_count]) ||
+          option_is_stream_marker(option, option->parsed_arguments.argv_arguments[valid_arg_count]));
          ++valid_arg_count) {};
 
     // at elast 1 value is required
     if (valid_arg_count < 1)
         return -1;
 
-    option->set_value = malloc(sizeof(char*) * (valid_arg_count + 1));
+    option->parsed_arguments.parameters = malloc(sizeof(char*) * valid_arg_count);
+    if (option->parsed_arguments.parameters == NULL)
+        return -1;
+
+    PARSE_STATS_ALLOCATION(sizeof(char*) * (size_t)valid_arg_count);
+
+    option->parsed_arguments.parameter_count = valid_arg_count;
+    for (int i = 0; i < valid_arg_count; ++i)
+        option->parsed_arguments.parameters[i] = option->parsed_arguments.argv_arguments[i];
+
+    if (!parse_append_values_(option, option->parsed_arguments.argv_arguments, (size_t)valid_arg_count, true))
+        return -1;
+
+    return valid_arg_count;
+}
+
+int parse_option__choice_(option_s* option)
+{
+    if (option == NULL)
+        return 0;
+
+    int consumed_count = 0;
+    const char* text_value = parse_read_first_val_(option, false, NULL, &consumed_count);
+    if (consumed_count == 0 || text_value == NULL)
+        return -1;
+
+    int choice = choices_find_(option->choices, text_value);
+    if (choice < 0)
+        return -1;
+
     if (option->set_value == NULL)
+    {
+        option->set_value = malloc(sizeof(int));
+        if (option->set_value == NULL)
+            return -1;
+
+        PARSE_STATS_ALLOCATION(sizeof(int));
+    }
+
+    *(int*)option->set_value = choice;
+    return consumed_count;
+}
+
+int parse_option__units_(option_s* option, bool (*parse_units)(const char*, size_t, uint64_t*))
+{
+    if (option == NULL)
+        return 0;
+
+    int consumed_count = 0;
+    const char* text_value = parse_read_first_val_(option, false, NULL, &consumed_count);
+    if (consumed_count == 0 || text_value == NULL)
         return -1;
 
-    option->parsed_arguments.parameters = malloc(sizeof(char*) * valid_arg_count);
-    if (option->parsed_arguments.parameters == NULL)
+    uint64_t units = 0;
+    if (!parse_units(text_value, strlen(text_value), &units))
+        return -1;
+
+    if (option->set_value == NULL)
     {
-        free(option->set_value);
-        option->set_value = NULL;
+        option->set_value = malloc(sizeof(uint64_t));
+        if (option->set_value == NULL)
+            return -1;
+
+        PARSE_STATS_ALLOCATION(sizeof(uint64_t));
+    }
+
+    *(uint64_t*)option->set_value = units;
+    return consumed_count;
+}
+
+int parse_option__custom_(option_s* option)
+{
+    if (option == NULL)
+        return 0;
+
+    int consumed_count = 0;
+    const char* text_value = parse_read_first_val_(option, false, NULL, &consumed_count);
+    if (consumed_count == 0 || text_value == NULL)
+        return -1;
+
+    // the value of a previous occurrence is dropped even when this one is rejected,
+    // so the value always belongs to the arguments of the latest occurrence
+    const option_type_vtable_s* custom_type = option->custom_type;
+    clean_custom_value_(custom_type, option->set_value);
+    option->set_value = NULL;
+
+    void* value = calloc(1, custom_type->value_size);
+    if (value == NULL)
+        return -1;
+
+    PARSE_STATS_ALLOCATION(custom_type->value_size);
+
+    if (!custom_type->parse(text_value, strlen(text_value), value, custom_type->context))
+    {
+        free(value);
         return -1;
     }
 
-    option->parsed_arguments.parameter_count = valid_arg_count;
+    option->set_value = value;
+    return consumed_count;
+}
 
-    for (int i = 0; i < valid_arg_count; ++i)
+bool set_option__strings_(option_s* option, const void* value)
+{
+    const char* const* values = &(const char*){value};
+    size_t value_count = 1;
+    bool null_terminate = option->type == OPTION_TYPE_MULTI_STRING;
+    if (null_terminate)
     {
-        ((const char**)option->set_value)[i] = option->parsed_arguments.argv_arguments[i];
-        option->parsed_arguments.parameters[i] = option->parsed_arguments.argv_arguments[i];
+        values = value;
+        for (value_count = 0; values[value_count] != NULL; ++value_count) {};
+        if (value_count == 0)
+            return false;
     }
 
-    ((char**)option->set_value)[valid_arg_count] = NULL;
-    return valid_arg_count;
+    // the new values replace every previous occurrence, whatever the repeat policy
+    option->value_count = 0;
+    size_t required_capacity = value_count + (null_terminate ? 1 : 0);
+    if (!dynamic_array_reserve(&option->set_value, &option->value_capacity, sizeof(char*), required_capacity))
+        return false;
+
+    const char** stored_values = option->set_value;
+    memcpy(stored_values, values, sizeof(char*) * value_count);
+    option->value_count = value_count;
+    if (null_terminate)
+        stored_values[value_count] = NULL;
+
+    option->is_overridden = true;
+    if (option->occurrence_count == 0)
+        option->occurrence_count = 1;
+
+    return true;
+}
+
+bool parse_append_values_(option_s* option, const char* const* values, size_t value_count, bool null_terminate)
+{
+    // every policy but accumulate replaces the values of a previous occurrence
+    if (option->repeat_policy != OPTION_REPEAT_ACCUMULATE)
+        option->value_count = 0;
+
+    size_t required_capacity = option->value_count + value_count + (null_terminate ? 1 : 0);
+    if (!dynamic_array_reserve(&option->set_value, &option->value_capacity, sizeof(char*), required_capacity))
+        return false;
+
+    const char** stored_values = option->set_value;
+    for (size_t i = 0; i < value_count; ++i)
+        stored_values[option->value_count + i] = values[i];
+
+    option->value_count += value_count;
+    if (null_terminate)
+        stored_values[option->value_count] = NULL;
+
+    return true;
 }
 
 void clean_option__string_(option_s* option)
 {
-    if (option == NULL || option->type != OPTION_TYPE_STRING || option->default_value.string_value == NULL)
+    if (option == NULL || option->type != OPTION_TYPE_STRING || option->default_value.string_value == NULL || option->is_borrowed)
         return;
 
     free(option->default_value.string_value);
@@ -489,7 +1069,7 @@ void clean_option__string_(option_s* option)
 
 void clean_option__multi_string_(option_s* option)
 {
-    if (option == NULL || option->type != OPTION_TYPE_MULTI_STRING || option->default_value.multi_string_value == NULL)
+    if (option == NULL || option->type != OPTION_TYPE_MULTI_STRING || option->default_value.multi_string_value == NULL || option->is_borrowed)
         return;
 
     for (size_t i = 0; option->default_value.multi_string_value[i] != NULL; ++i)
@@ -498,6 +1078,95 @@ void clean_option__multi_string_(option_s* option)
     free(option->default_value.multi_string_value);
 }
 
+option_choices_s* choices_create_(const char* const* names, size_t count)
+{
+    string_set_s seen_names = {0};
+    if (!string_set_init(&seen_names, count))
+        return NULL;
+
+    size_t string_size = 0;
+    bool is_valid = true;
+    for (size_t i = 0; i < count && is_valid; ++i)
+    {
+        bool was_present = false;
+        is_valid = names[i] != NULL &&
+                   string_set_insert(&seen_names, names[i], strlen(names[i]), &was_present) &&
+                   !was_present;
+
+        if (is_valid)
+            string_size += strlen(names[i]) + 1;
+    }
+
+    string_set_clean(&seen_names);
+    if (!is_valid)
+        return NULL;
+
+    // the names, slots and displacements follow the structure directly, so the choices are a single allocation
+    size_t bucket_count = perfect_hash_bucket_count(count);
+    size_t slot_count = perfect_hash_slot_count(count);
+    for (size_t attempt = 0; attempt < OPTION_CHOICES_MAX_GROW_ATTEMPTS; ++attempt, slot_count *= 2)
+    {
+        size_t names_offset = sizeof(option_choices_s);
+        size_t slots_offset = names_offset + sizeof(char*) * count;
+        size_t displacements_offset = slots_offset + sizeof(uint32_t) * slot_count;
+        size_t strings_offset = displacements_offset + sizeof(uint32_t) * bucket_count;
+
+        unsigned char* block = malloc(strings_offset + string_size);
+        if (block == NULL)
+            return NULL;
+
+        option_choices_s* choices = (option_choices_s*)block;
+        choices->count = count;
+        choices->names = (char**)(block + names_offset);
+        choices->slot_count = slot_count;
+        choices->slots = (uint32_t*)(block + slots_offset);
+        choices->bucket_count = bucket_count;
+        choices->displacements = (uint32_t*)(block + displacements_offset);
+
+        if (!perfect_hash_build(names, count, choices->slots, slot_count, choices->displacements, bucket_count))
+        {
+            free(block);
+            continue;
+        }
+
+        char* next_string = (char*)(block + strings_offset);
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t length = strlen(names[i]) + 1;
+            memcpy(next_string, names[i], length);
+            choices->names[i] = next_string;
+            next_string += length;
+        }
+
+        return choices;
+    }
+
+    return NULL;
+}
+
+int choices_find_(const option_choices_s* choices, const char* value)
+{
+    if (choices == NULL || value == NULL)
+        return -1;
+
+    size_t slot = perfect_hash_slot(value, strlen(value), choices->displacements, choices->bucket_count, choices->slot_count);
+    uint32_t entry = choices->slots[slot];
+    if (entry == 0 || strcmp(choices->names[entry - 1], value) != 0)
+        return -1;
+
+    return (int)(entry - 1);
+}
+
+void clean_custom_value_(const option_type_vtable_s* custom_type, void* value)
+{
+    if (value == NULL)
+        return;
+
+    if (custom_type != NULL && custom_type->clean != NULL)
+        custom_type->clean(value, custom_type->context);
+
+    free(value);
+}
 
 void notation_generic_cleaner_(void* notation) { notation_clean(notation); }
 
@@ -0,0 +1,165 @@
+#include "option_stream.h"
+
+#include "option.h"
+#include "command.h"
+#include "parse_stats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+typedef struct option_stream_chunk_
+{
+    char* buffer;
+    const char* values[OPTION_STREAM_CHUNK_VALUES];
+    size_t count;
+    size_t total_count;
+} option_stream_chunk_s;
+
+static bool option_stream_push_(const option_s* option, option_stream_chunk_s* chunk, const char* value);
+static bool option_stream_flush_(const option_s* option, option_stream_chunk_s* chunk);
+static bool option_stream_read_(const option_s* option, option_stream_chunk_s* chunk, FILE* stream);
+static bool option_stream_push_record_(const option_s* option, option_stream_chunk_s* chunk, char* record, size_t length);
+
+// END LOCAL DEFINITIONS //
+
+bool option_stream_values(const option_s* option, FILE* stream, size_t* value_count)
+{
+    if (value_count != NULL)
+        *value_count = 0;
+
+    if (option == NULL || option->type != OPTION_TYPE_MULTI_STRING || option->stream_callback == NULL)
+        return false;
+
+    size_t count = 0;
+    const char** values = option_read_multi_string(option, &count);
+    if (values == NULL)
+        return true;
+
+    // the values from argv are handed over in place, only a stream needs a buffer to read into
+    option_stream_chunk_s chunk = {0};
+    bool success = true;
+    for (size_t i = 0; i < count && success; ++i)
+    {
+        if (!option_is_stream_marker(option, values[i]))
+        {
+            success = option_stream_push_(option, &chunk, values[i]);
+            continue;
+        }
+
+        success = option_stream_read_(option, &chunk, stream);
+    }
+
+    success = success && option_stream_flush_(option, &chunk);
+    free(chunk.buffer);
+
+    if (value_count != NULL)
+        *value_count = chunk.total_count;
+    return success;
+}
+
+bool command_stream_option(const command_s* command, const char* option_flag, FILE* stream, size_t* value_count)
+{
+    const option_s* found_option = command_find_option(command, option_flag);
+    return option_stream_values(found_option, stream, value_count);
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+bool option_stream_push_(const option_s* option, option_stream_chunk_s* chunk, const char* value)
+{
+    if (chunk->count == OPTION_STREAM_CHUNK_VALUES && !option_stream_flush_(option, chunk))
+        return false;
+
+    chunk->values[chunk->count++] = value;
+    return true;
+}
+
+bool option_stream_flush_(const option_s* option, option_stream_chunk_s* chunk)
+{
+    if (chunk->count == 0)
+        return true;
+
+    size_t count = chunk->count;
+    chunk->count = 0;
+    chunk->total_count += count;
+    return option->stream_callback(option, chunk->values, count, option->stream_context);
+}
+
+bool option_stream_read_(const option_s* option, option_stream_chunk_s* chunk, FILE* stream)
+{
+    if (stream == NULL)
+        return false;
+
+    if (chunk->buffer == NULL)
+    {
+        chunk->buffer = malloc(OPTION_STREAM_CHUNK_SIZE);
+        if (chunk->buffer == NULL)
+            return false;
+
+        PARSE_STATS_ALLOCATION(OPTION_STREAM_CHUNK_SIZE);
+    }
+
+    char* buffer = chunk->buffer;
+    char delimiter = option->stream_delimiter;
+    size_t filled = 0;
+
+    for (;;)
+    {
+        // one byte is always left, so the last record can be terminated when the stream doesn't end in a delimiter
+        size_t read_count = fread(buffer + filled, 1, OPTION_STREAM_CHUNK_SIZE - 1 - filled, stream);
+        if (read_count == 0)
+            break;
+
+        size_t record_start = 0;
+        size_t end = filled + read_count;
+        for (size_t i = filled; i < end; ++i)
+        {
+            if (buffer[i] != delimiter)
+                continue;
+
+            if (!option_stream_push_record_(option, chunk, buffer + record_start, i - record_start))
+                return false;
+
+            record_start = i + 1;
+        }
+
+        // the values point into the buffer, so they're handed over before the unfinished record moves to the front
+        if (!option_stream_flush_(option, chunk))
+            return false;
+
+        filled = end - record_start;
+        memmove(buffer, buffer + record_start, filled);
+        if (filled < OPTION_STREAM_CHUNK_SIZE - 1)
+            continue;
+
+        // a full buffer holds a single record, which still fits when the stream or the record ends right after it
+        int next = fgetc(stream);
+        if (next == EOF)
+            break;
+        if (next != (unsigned char)delimiter)
+            return false;
+
+        if (!option_stream_push_record_(option, chunk, buffer, filled) || !option_stream_flush_(option, chunk))
+            return false;
+        filled = 0;
+    }
+
+    if (ferror(stream))
+        return false;
+
+    return option_stream_push_record_(option, chunk, buffer, filled) && option_stream_flush_(option, chunk);
+}
+
+bool option_stream_push_record_(const option_s* option, option_stream_chunk_s* chunk, char* record, size_t length)
+{
+    if (option->stream_delimiter == '\n' && length > 0 && record[length - 1] == '\r')
+        length--;
+
+    // terminated in place, over its delimiter or over the byte the buffer always keeps free
+    record[length] = '\0';
+    return length == 0 || option_stream_push_(option, chunk, record);
+}
+
+// END LOCAL IMPLEMENTATIONS //
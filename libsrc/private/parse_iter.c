@@ -0,0 +1,119 @@
+#include "parse_iter.h"
+
+#include "command.h"
+#include "option.h"
+#include "notation.h"
+
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+static bool parse_iter_yield_(parse_iter_s* iter, parse_event_s* event, parse_event_kind_e kind, const option_s* option, size_t consumed);
+static bool parse_iter_next_option_(parse_iter_s* iter, parse_event_s* event, const option_s* option);
+
+// END LOCAL DEFINITIONS //
+
+bool parse_iter_init(parse_iter_s* iter, const command_s* command, int argc, const char* const* argv)
+{
+    if (iter == NULL || command == NULL || argc < 0 || (argv == NULL && argc > 0))
+        return false;
+
+    *iter = (parse_iter_s){
+        .command = command,
+        .argv = argv,
+        .argv_count = (size_t)argc,
+        .next_index = 0,
+        .multi_option = NULL,
+        .is_passthrough = false
+    };
+    return true;
+}
+
+bool parse_iter_next(parse_iter_s* iter, parse_event_s* event)
+{
+    if (iter == NULL || event == NULL)
+        return false;
+
+    if (iter->next_index >= iter->argv_count)
+        return false;
+
+    const char* argument = iter->argv[iter->next_index];
+    if (iter->is_passthrough)
+        return parse_iter_yield_(iter, event, PARSE_EVENT_PASSTHROUGH, NULL, 0);
+
+    // the values of a multi-string option run up to the next flag, just like `command_parse()` reads them
+    bool is_flag = notation_is_valid_flag(argument);
+    if (iter->multi_option != NULL)
+    {
+        if (!is_flag || option_is_stream_marker(iter->multi_option, argument))
+            return parse_iter_yield_(iter, event, PARSE_EVENT_VALUE, iter->multi_option, 0);
+
+        iter->multi_option = NULL;
+    }
+
+    if (strcmp(argument, COMMAND_END_OF_OPTIONS) == 0)
+    {
+        iter->is_passthrough = true;
+        iter->next_index++;
+        return parse_iter_next(iter, event);
+    }
+
+    if (!is_flag)
+        return parse_iter_yield_(iter, event, PARSE_EVENT_POSITIONAL, NULL, 0);
+
+    const option_s* option = command_find_option(iter->command, argument);
+    if (option == NULL)
+        return parse_iter_yield_(iter, event, PARSE_EVENT_UNKNOWN_FLAG, NULL, 0);
+
+    return parse_iter_next_option_(iter, event, option);
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+bool parse_iter_yield_(parse_iter_s* iter, parse_event_s* event, parse_event_kind_e kind, const option_s* option, size_t consumed)
+{
+    *event = (parse_event_s){
+        .kind = kind,
+        .argv_index = iter->next_index,
+        .text = iter->argv[iter->next_index],
+        .value = consumed > 0 ? iter->argv[iter->next_index + 1] : NULL,
+        .option = option
+    };
+
+    iter->next_index += 1 + consumed;
+    return true;
+}
+
+bool parse_iter_next_option_(parse_iter_s* iter, parse_event_s* event, const option_s* option)
+{
+    // options never consume the end-of-options marker, as `command_parse()` bounds them by it as well
+    size_t value_index = iter->next_index + 1;
+    bool has_value = value_index < iter->argv_count && strcmp(iter->argv[value_index], COMMAND_END_OF_OPTIONS) != 0;
+
+    switch (option->type)
+    {
+    case OPTION_TYPE_BOOL:
+        return parse_iter_yield_(iter, event, PARSE_EVENT_OPTION, option, 0);
+
+    // falls back to `0` when nothing follows
+    case OPTION_TYPE_INT:
+    case OPTION_TYPE_FLOAT:
+        return parse_iter_yield_(iter, event, PARSE_EVENT_OPTION, option, has_value ? 1 : 0);
+
+    case OPTION_TYPE_MULTI_STRING:
+        if (!has_value ||
+            (notation_is_valid_flag(iter->argv[value_index]) && !option_is_stream_marker(option, iter->argv[value_index])))
+            return parse_iter_yield_(iter, event, PARSE_EVENT_MISSING_VALUE, option, 0);
+
+        iter->multi_option = option;
+        return parse_iter_yield_(iter, event, PARSE_EVENT_OPTION, option, 0);
+
+    default:
+        if (!has_value)
+            return parse_iter_yield_(iter, event, PARSE_EVENT_MISSING_VALUE, option, 0);
+
+        return parse_iter_yield_(iter, event, PARSE_EVENT_OPTION, option, 1);
+    }
+}
+
+// END LOCAL IMPLEMENTATIONS //
@@ -0,0 +1,474 @@
+#include "parse_result.h"
+
+#include "option.h"
+#include "extra/bitset.h"
+
+#include <string.h>
+
+// LOCAL DEFINITIONS //
+
+#define PARSE_RESULT_MAGIC   0x52504143u /* "CAPR" */
+#define PARSE_RESULT_VERSION 4u
+
+#define PARSE_RESULT_OPTION_PRESENT 1u
+
+typedef struct parse_result_header_
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t total_size;
+    uint32_t command_index;
+    uint32_t option_count;
+    uint32_t global_option_count;
+    uint32_t parameter_count;
+    uint32_t passthrough_count;
+    uint32_t options_offset;
+    uint32_t parameters_offset;
+    uint32_t passthrough_offset;
+} parse_result_header_s;
+
+typedef struct parse_result_option_
+{
+    uint32_t type;
+    uint32_t flags;
+    uint32_t value_count;
+    uint32_t reserved;
+    uint64_t value; /**< the value itself for scalar types, the offset of the string-offsets for text types. */
+} parse_result_option_s;
+
+static const command_s* parse_result_globals_(const command_s* command);
+static void parse_result_write_strings_(unsigned char* data, const char* const* strings, size_t count,
+                                        size_t* next_offset, size_t* next_string);
+static void parse_result_measure_options_(const command_s* command, size_t* offset_count, size_t* string_bytes);
+static void parse_result_write_options_(const command_s* command, unsigned char* data, size_t records_offset,
+                                        size_t* next_offset, size_t* next_string);
+static const char* const* parse_result_option_strings_(const option_s* option, const char** single, size_t* count);
+static bool parse_result_read_record_(const parse_result_view_s* view, size_t option_index, parse_result_option_s* record);
+static const char* parse_result_string_at_(const parse_result_view_s* view, uint64_t offsets_offset, size_t index);
+
+// END LOCAL DEFINITIONS //
+
+size_t parse_result_write(const command_tree_s* tree, const command_s* command, void* buffer, size_t buffer_length)
+{
+    if (tree == NULL || command == NULL || command < tree->commands || command >= tree->commands + tree->command_count)
+        return 0;
+
+    // first pass: size up the offset and string sections
+    size_t offset_count = command->parsed_arguments.parameter_count + command->passthrough_count;
+    size_t string_bytes = 1; // the blob always ends with a NUL byte
+
+    for (size_t i = 0; i < command->parsed_arguments.parameter_count; ++i)
+        string_bytes += strlen(command->parsed_arguments.parameters[i]) + 1;
+
+    for (size_t i = 0; i < command->passthrough_count; ++i)
+        string_bytes += strlen(command->passthrough[i]) + 1;
+
+    // the global options hold values of this parse as well, their records follow those of the command
+    const command_s* globals = parse_result_globals_(command);
+    size_t global_option_count = globals != NULL ? globals->option_count : 0;
+
+    parse_result_measure_options_(command, &offset_count, &string_bytes);
+    if (globals != NULL)
+        parse_result_measure_options_(globals, &offset_count, &string_bytes);
+
+    size_t options_offset = sizeof(parse_result_header_s);
+    size_t offsets_offset = options_offset + sizeof(parse_result_option_s) * (command->option_count + global_option_count);
+    size_t strings_offset = offsets_offset + sizeof(uint32_t) * offset_count;
+    size_t total_size = strings_offset + string_bytes;
+
+    if (total_size > UINT32_MAX)
+        return 0;
+
+    if (buffer == NULL || buffer_length < total_size)
+        return total_size;
+
+    // second pass: write every section
+    unsigned char* data = buffer;
+    size_t next_offset = offsets_offset;
+    size_t next_string = strings_offset;
+
+    parse_result_header_s header = {
+        .magic = PARSE_RESULT_MAGIC,
+        .version = PARSE_RESULT_VERSION,
+        .total_size = (uint32_t)total_size,
+        .command_index = (uint32_t)(command - tree->commands),
+        .option_count = (uint32_t)command->option_count,
+        .global_option_count = (uint32_t)global_option_count,
+        .parameter_count = (uint32_t)command->parsed_arguments.parameter_count,
+        .passthrough_count = (uint32_t)command->passthrough_count,
+        .options_offset = (uint32_t)options_offset,
+        .parameters_offset = (uint32_t)offsets_offset,
+        .passthrough_offset = (uint32_t)(offsets_offset + sizeof(uint32_t) * command->parsed_arguments.parameter_count)
+    };
+    memcpy(data, &header, sizeof(header));
+
+    parse_result_write_strings_(data, command->parsed_arguments.parameters, command->parsed_arguments.parameter_count,
+                                &next_offset, &next_string);
+    parse_result_write_strings_(data, command->passthrough, command->passthrough_count, &next_offset, &next_string);
+
+    parse_result_write_options_(command, data, options_offset, &next_offset, &next_string);
+    if (globals != NULL)
+        parse_result_write_options_(globals, data, options_offset + sizeof(parse_result_option_s) * command->option_count,
+                                    &next_offset, &next_string);
+
+    data[next_string] = '\0';
+    return total_size;
+}
+
+bool parse_result_view_init(parse_result_view_s* view, const void* data, size_t length)
+{
+    if (view == NULL || data == NULL || length < sizeof(parse_result_header_s))
+        return false;
+
+    parse_result_header_s header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != PARSE_RESULT_MAGIC || header.version != PARSE_RESULT_VERSION)
+        return false;
+
+    if (header.total_size > length || header.total_size <= sizeof(header))
+        return false;
+
+    const unsigned char* bytes = data;
+    size_t options_end = (size_t)header.options_offset +
+                         sizeof(parse_result_option_s) * ((size_t)header.option_count + header.global_option_count);
+    size_t parameters_end = (size_t)header.parameters_offset + sizeof(uint32_t) * (size_t)header.parameter_count;
+    size_t passthrough_end = (size_t)header.passthrough_offset + sizeof(uint32_t) * (size_t)header.passthrough_count;
+
+    // the trailing NUL guarantees every string inside of the blob is terminated
+    if (options_end > header.total_size || parameters_end > header.total_size || passthrough_end > header.total_size ||
+        bytes[header.total_size - 1] != '\0')
+        return false;
+
+    view->data_ = bytes;
+    view->length_ = header.total_size;
+    view->command_index_ = header.command_index;
+    view->option_count_ = header.option_count;
+    view->global_option_count_ = header.global_option_count;
+    view->parameter_count_ = header.parameter_count;
+    view->options_offset_ = header.options_offset;
+    view->parameters_offset_ = header.parameters_offset;
+    view->passthrough_count_ = header.passthrough_count;
+    view->passthrough_offset_ = header.passthrough_offset;
+    return true;
+}
+
+size_t parse_result_get_command_index(const parse_result_view_s* view)
+{
+    if (view == NULL)
+        return 0;
+
+    return view->command_index_;
+}
+
+size_t parse_result_get_option_count(const parse_result_view_s* view)
+{
+    if (view == NULL)
+        return 0;
+
+    return view->option_count_;
+}
+
+size_t parse_result_get_global_option_count(const parse_result_view_s* view)
+{
+    if (view == NULL)
+        return 0;
+
+    return view->global_option_count_;
+}
+
+size_t parse_result_get_parameter_count(const parse_result_view_s* view)
+{
+    if (view == NULL)
+        return 0;
+
+    return view->parameter_count_;
+}
+
+const char* parse_result_get_parameter(const parse_result_view_s* view, size_t parameter_index)
+{
+    if (view == NULL || parameter_index >= view->parameter_count_)
+        return NULL;
+
+    return parse_result_string_at_(view, view->parameters_offset_, parameter_index);
+}
+
+size_t parse_result_get_passthrough_count(const parse_result_view_s* view)
+{
+    if (view == NULL)
+        return 0;
+
+    return view->passthrough_count_;
+}
+
+const char* parse_result_get_passthrough(const parse_result_view_s* view, size_t passthrough_index)
+{
+    if (view == NULL || passthrough_index >= view->passthrough_count_)
+        return NULL;
+
+    return parse_result_string_at_(view, view->passthrough_offset_, passthrough_index);
+}
+
+bool parse_result_is_option_present(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record))
+        return false;
+
+    return (record.flags & PARSE_RESULT_OPTION_PRESENT) != 0;
+}
+
+option_type_e parse_result_get_option_type(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record))
+        return MAX_OPTION_TYPE_COUNT;
+
+    return (option_type_e)record.type;
+}
+
+bool parse_result_read_bool(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_BOOL)
+        return false;
+
+    return record.value != 0;
+}
+
+int parse_result_read_int(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_INT)
+        return 0;
+
+    int value = 0;
+    memcpy(&value, &record.value, sizeof(value));
+    return value;
+}
+
+int parse_result_read_choice(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_CHOICE)
+        return -1;
+
+    int value = 0;
+    memcpy(&value, &record.value, sizeof(value));
+    return value;
+}
+
+uint64_t parse_result_read_size(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_SIZE)
+        return 0;
+
+    return record.value;
+}
+
+uint64_t parse_result_read_duration(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_DURATION)
+        return 0;
+
+    return record.value;
+}
+
+float parse_result_read_float(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_FLOAT)
+        return 0.0f;
+
+    float value = 0.0f;
+    memcpy(&value, &record.value, sizeof(value));
+    return value;
+}
+
+const char* parse_result_read_string(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || record.type != OPTION_TYPE_STRING || record.value_count == 0)
+        return NULL;
+
+    // just like `option_read_string()`, the latest occurrence is the one that counts
+    return parse_result_string_at_(view, record.value, record.value_count - 1);
+}
+
+size_t parse_result_read_string_count(const parse_result_view_s* view, size_t option_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record))
+        return 0;
+
+    if (record.type != OPTION_TYPE_STRING && record.type != OPTION_TYPE_MULTI_STRING && record.type != OPTION_TYPE_CUSTOM)
+        return 0;
+
+    return record.value_count;
+}
+
+const char* parse_result_read_string_at(const parse_result_view_s* view, size_t option_index, size_t string_index)
+{
+    parse_result_option_s record;
+    if (!parse_result_read_record_(view, option_index, &record) || string_index >= record.value_count)
+        return NULL;
+
+    if (record.type != OPTION_TYPE_STRING && record.type != OPTION_TYPE_MULTI_STRING && record.type != OPTION_TYPE_CUSTOM)
+        return NULL;
+
+    return parse_result_string_at_(view, record.value, string_index);
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+const command_s* parse_result_globals_(const command_s* command)
+{
+    // the tree binds its global options to the called command, which is never bound to itself
+    if (command->globals == NULL || command->globals == command || command->globals->option_count == 0)
+        return NULL;
+
+    return command->globals;
+}
+
+void parse_result_write_strings_(unsigned char* data, const char* const* strings, size_t count,
+                                 size_t* next_offset, size_t* next_string)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length = strlen(strings[i]) + 1;
+        uint32_t string_offset = (uint32_t)*next_string;
+
+        memcpy(data + *next_string, strings[i], length);
+        memcpy(data + *next_offset, &string_offset, sizeof(uint32_t));
+        *next_string += length;
+        *next_offset += sizeof(uint32_t);
+    }
+}
+
+void parse_result_measure_options_(const command_s* command, size_t* offset_count, size_t* string_bytes)
+{
+    for (size_t i = 0; i < command->option_count; ++i)
+    {
+        const char* single = NULL;
+        size_t count = 0;
+        const char* const* strings = parse_result_option_strings_(&command->options[i], &single, &count);
+
+        *offset_count += count;
+        for (size_t j = 0; j < count; ++j)
+            *string_bytes += strlen(strings[j]) + 1;
+    }
+}
+
+void parse_result_write_options_(const command_s* command, unsigned char* data, size_t records_offset,
+                                 size_t* next_offset, size_t* next_string)
+{
+    for (size_t i = 0; i < command->option_count; ++i)
+    {
+        const option_s* option = &command->options[i];
+        parse_result_option_s record = {
+            .type = (uint32_t)option->type,
+            .flags = command->option_word_count > 0 && bitset_test(command->present_options, i) ? PARSE_RESULT_OPTION_PRESENT : 0
+        };
+
+        switch (option->type)
+        {
+        case OPTION_TYPE_BOOL:
+            record.value = option_read_bool(option);
+        break;
+        case OPTION_TYPE_INT:
+        {
+            int value = option_read_int(option);
+            memcpy(&record.value, &value, sizeof(value));
+        }
+        break;
+        case OPTION_TYPE_FLOAT:
+        {
+            float value = option_read_float(option);
+            memcpy(&record.value, &value, sizeof(value));
+        }
+        break;
+        case OPTION_TYPE_CHOICE:
+        {
+            int value = option_read_choice(option);
+            memcpy(&record.value, &value, sizeof(value));
+        }
+        break;
+        case OPTION_TYPE_SIZE:
+            record.value = option_read_size(option);
+        break;
+        case OPTION_TYPE_DURATION:
+            record.value = option_read_duration(option);
+        break;
+
+        default:
+        {
+            const char* single = NULL;
+            size_t count = 0;
+            const char* const* strings = parse_result_option_strings_(option, &single, &count);
+
+            record.value = *next_offset;
+            record.value_count = (uint32_t)count;
+            parse_result_write_strings_(data, strings, count, next_offset, next_string);
+        }
+        break;
+        }
+
+        memcpy(data + records_offset + sizeof(parse_result_option_s) * i, &record, sizeof(record));
+    }
+}
+
+const char* const* parse_result_option_strings_(const option_s* option, const char** single, size_t* count)
+{
+    *count = 0;
+
+    if (option->type == OPTION_TYPE_MULTI_STRING ||
+        (option->type == OPTION_TYPE_STRING && option->repeat_policy == OPTION_REPEAT_ACCUMULATE))
+    {
+        const char** strings = option_read_string_list(option, count);
+        if (strings == NULL)
+            *count = 0;
+
+        return strings;
+    }
+
+    // the converted value of a user-defined type is only meaningful within this process, the passed text is not
+    if (option->type == OPTION_TYPE_CUSTOM)
+    {
+        *count = option->set_value != NULL ? option->parsed_arguments.parameter_count : 0;
+        return *count > 0 ? option->parsed_arguments.parameters : NULL;
+    }
+
+    if (option->type != OPTION_TYPE_STRING)
+        return NULL;
+
+    *single = option_read_string(option);
+    *count = *single != NULL;
+    return single;
+}
+
+bool parse_result_read_record_(const parse_result_view_s* view, size_t option_index, parse_result_option_s* record)
+{
+    if (view == NULL || view->data_ == NULL || option_index >= (size_t)view->option_count_ + view->global_option_count_)
+        return false;
+
+    memcpy(record, view->data_ + view->options_offset_ + sizeof(parse_result_option_s) * option_index, sizeof(*record));
+    return true;
+}
+
+const char* parse_result_string_at_(const parse_result_view_s* view, uint64_t offsets_offset, size_t index)
+{
+    uint64_t entry_offset = offsets_offset + sizeof(uint32_t) * (uint64_t)index;
+    if (entry_offset + sizeof(uint32_t) > view->length_)
+        return NULL;
+
+    uint32_t string_offset = 0;
+    memcpy(&string_offset, view->data_ + entry_offset, sizeof(uint32_t));
+    if (string_offset >= view->length_)
+        return NULL;
+
+    return (const char*)view->data_ + string_offset;
+}
+
+// END LOCAL IMPLEMENTATIONS //
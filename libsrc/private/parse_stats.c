@@ -0,0 +1,166 @@
+#include "parse_stats.h"
+
+#include <string.h>
+#include <inttypes.h>
+
+#if defined(COMMAND_PARSER_ENABLE_STATS)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+// LOCAL DEFINITIONS //
+
+static const char* const parse_stats_phase_names_[MAX_PARSE_STATS_PHASE_COUNT] = {
+    [PARSE_STATS_PHASE_CONSTRUCTION] = "construction",
+    [PARSE_STATS_PHASE_PARSE_BASE] = "parse_base",
+    [PARSE_STATS_PHASE_COMMAND_PARSE] = "command_parse",
+    [PARSE_STATS_PHASE_CONVERSION] = "conversion",
+    [PARSE_STATS_PHASE_CLEAN] = "clean",
+};
+
+static const char* const parse_stats_counter_names_[MAX_PARSE_STATS_COUNTER_COUNT] = {
+    [PARSE_STATS_ARGS_SCANNED] = "args_scanned",
+    [PARSE_STATS_FLAG_LOOKUPS] = "flag_lookups",
+    [PARSE_STATS_STRING_COMPARES] = "string_compares",
+    [PARSE_STATS_ALLOCATIONS] = "allocations",
+    [PARSE_STATS_ALLOCATED_BYTES] = "allocated_bytes",
+};
+
+#if defined(COMMAND_PARSER_ENABLE_STATS)
+
+#if defined(_WIN32)
+#define PARSE_STATS_THREAD_LOCAL __declspec(thread)
+#else
+#define PARSE_STATS_THREAD_LOCAL _Thread_local
+#endif
+
+static PARSE_STATS_THREAD_LOCAL parse_stats_s* parse_stats_current_ = NULL;
+
+static uint64_t parse_stats_now_(void);
+
+#endif // COMMAND_PARSER_ENABLE_STATS
+
+// END LOCAL DEFINITIONS //
+
+bool parse_stats_enabled(void)
+{
+#if defined(COMMAND_PARSER_ENABLE_STATS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool command_tree_get_stats(const command_tree_s* tree, parse_stats_s* stats)
+{
+    if (tree == NULL || stats == NULL || !parse_stats_enabled())
+        return false;
+
+    memcpy(stats, &tree->stats, sizeof(parse_stats_s));
+    return true;
+}
+
+void command_tree_reset_stats(command_tree_s* tree)
+{
+    if (tree == NULL)
+        return;
+
+    tree->stats = (parse_stats_s){0};
+}
+
+const char* parse_stats_phase_name(parse_stats_phase_e phase)
+{
+    if ((size_t)phase >= MAX_PARSE_STATS_PHASE_COUNT)
+        return NULL;
+
+    return parse_stats_phase_names_[phase];
+}
+
+const char* parse_stats_counter_name(parse_stats_counter_e counter)
+{
+    if ((size_t)counter >= MAX_PARSE_STATS_COUNTER_COUNT)
+        return NULL;
+
+    return parse_stats_counter_names_[counter];
+}
+
+void parse_stats_dump(FILE* stream, const parse_stats_s* stats)
+{
+    if (stream == NULL || stats == NULL)
+        return;
+
+    for (size_t i = 0; i < MAX_PARSE_STATS_PHASE_COUNT; ++i)
+    {
+        fprintf(stream, "%s.ns %" PRIu64 "\n", parse_stats_phase_names_[i], stats->phase_nanoseconds[i]);
+        fprintf(stream, "%s.calls %" PRIu64 "\n", parse_stats_phase_names_[i], stats->phase_calls[i]);
+    }
+
+    for (size_t i = 0; i < MAX_PARSE_STATS_COUNTER_COUNT; ++i)
+        fprintf(stream, "%s %" PRIu64 "\n", parse_stats_counter_names_[i], stats->counters[i]);
+}
+
+#if defined(COMMAND_PARSER_ENABLE_STATS)
+
+parse_stats_frame_s parse_stats_begin(parse_stats_s* stats, parse_stats_phase_e phase)
+{
+    parse_stats_frame_s frame = {
+        .stats_ = stats != NULL ? stats : parse_stats_current_,
+        .previous_ = parse_stats_current_,
+        .phase_ = phase,
+        .start_ = 0
+    };
+
+    if (frame.stats_ == NULL)
+        return frame;
+
+    parse_stats_current_ = frame.stats_;
+    frame.start_ = parse_stats_now_();
+    return frame;
+}
+
+void parse_stats_end(const parse_stats_frame_s* frame)
+{
+    if (frame->stats_ == NULL)
+        return;
+
+    frame->stats_->phase_nanoseconds[frame->phase_] += parse_stats_now_() - frame->start_;
+    frame->stats_->phase_calls[frame->phase_]++;
+    parse_stats_current_ = frame->previous_;
+}
+
+void parse_stats_count(parse_stats_counter_e counter, uint64_t amount)
+{
+    if (parse_stats_current_ != NULL)
+        parse_stats_current_->counters[counter] += amount;
+}
+
+#endif // COMMAND_PARSER_ENABLE_STATS
+
+// LOCAL IMPLEMENTATIONS //
+
+#if defined(COMMAND_PARSER_ENABLE_STATS)
+
+uint64_t parse_stats_now_(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = {0};
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000u +
+           (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000u / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+#endif // COMMAND_PARSER_ENABLE_STATS
+
+// END LOCAL IMPLEMENTATIONS //
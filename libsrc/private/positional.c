@@ -0,0 +1,217 @@
+#include "positional.h"
+
+#include "option.h"
+
+#include "extra/dynamic_array.h"
+#include "extra/unit_suffix.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+
+// LOCAL DEFINITIONS //
+
+static bool init_positional_(positional_s* positional, const char* name, option_type_e type, size_t min_count, size_t max_count, bool is_borrowed);
+static bool positional_type_is_valid_(option_type_e type);
+static bool positional_convert_(const positional_s* positional, const char* parameter, void* value);
+static bool positional_in_range_(const positional_s* positional, size_t index, option_type_e type);
+
+// END LOCAL DEFINITIONS //
+
+bool positional_init(positional_s* positional, const char* name, option_type_e type, size_t min_count, size_t max_count)
+{
+    return init_positional_(positional, name, type, min_count, max_count, false);
+}
+
+bool positional_init_borrowed(positional_s* positional, const char* name, option_type_e type, size_t min_count, size_t max_count)
+{
+    return init_positional_(positional, name, type, min_count, max_count, true);
+}
+
+void positional_clean(positional_s* positional)
+{
+    if (positional == NULL)
+        return;
+
+    if (!positional->is_borrowed)
+        free(positional->name);
+    positional->name = NULL;
+
+    free(positional->values);
+    positional->values = NULL;
+    positional->value_count = 0;
+    positional->value_capacity = 0;
+}
+
+bool positional_parse(positional_s* positional, const char* const* parameters, size_t parameter_count, size_t* invalid_index)
+{
+    if (positional == NULL || (parameters == NULL && parameter_count > 0) || invalid_index == NULL)
+        return false;
+
+    positional->value_count = 0;
+    size_t value_size = option_value_size(positional->type, NULL);
+    if (!dynamic_array_reserve(&positional->values, &positional->value_capacity, value_size, parameter_count))
+    {
+        *invalid_index = parameter_count;
+        return false;
+    }
+
+    unsigned char* values = positional->values;
+    for (size_t i = 0; i < parameter_count; ++i)
+    {
+        if (!positional_convert_(positional, parameters[i], values + value_size * i))
+        {
+            *invalid_index = i;
+            return false;
+        }
+    }
+
+    positional->value_count = parameter_count;
+    return true;
+}
+
+void positional_reset(positional_s* positional)
+{
+    if (positional == NULL)
+        return;
+
+    positional->value_count = 0;
+}
+
+const char* positional_get_name(const positional_s* positional)
+{
+    if (positional == NULL)
+        return NULL;
+
+    return positional->name;
+}
+
+bool positional_is_variadic(const positional_s* positional)
+{
+    return positional != NULL && positional->max_count == POSITIONAL_UNBOUNDED;
+}
+
+size_t positional_get_count(const positional_s* positional)
+{
+    if (positional == NULL)
+        return 0;
+
+    return positional->value_count;
+}
+
+int positional_read_int(const positional_s* positional, size_t index)
+{
+    if (!positional_in_range_(positional, index, OPTION_TYPE_INT))
+        return 0;
+
+    return ((const int*)positional->values)[index];
+}
+
+float positional_read_float(const positional_s* positional, size_t index)
+{
+    if (!positional_in_range_(positional, index, OPTION_TYPE_FLOAT))
+        return 0.0f;
+
+    return ((const float*)positional->values)[index];
+}
+
+const char* positional_read_string(const positional_s* positional, size_t index)
+{
+    if (!positional_in_range_(positional, index, OPTION_TYPE_STRING))
+        return NULL;
+
+    return ((const char* const*)positional->values)[index];
+}
+
+uint64_t positional_read_size(const positional_s* positional, size_t index)
+{
+    if (!positional_in_range_(positional, index, OPTION_TYPE_SIZE))
+        return 0;
+
+    return ((const uint64_t*)positional->values)[index];
+}
+
+uint64_t positional_read_duration(const positional_s* positional, size_t index)
+{
+    if (!positional_in_range_(positional, index, OPTION_TYPE_DURATION))
+        return 0;
+
+    return ((const uint64_t*)positional->values)[index];
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+bool init_positional_(positional_s* positional, const char* name, option_type_e type, size_t min_count, size_t max_count, bool is_borrowed)
+{
+    if (positional == NULL || name == NULL || !positional_type_is_valid_(type) ||
+        max_count == 0 || max_count < min_count)
+        return false;
+
+    *positional = (positional_s){
+        .name = is_borrowed ? (char*)name : strdup(name),
+        .is_borrowed = is_borrowed,
+        .type = type,
+        .min_count = min_count,
+        .max_count = max_count
+    };
+
+    return positional->name != NULL;
+}
+
+bool positional_type_is_valid_(option_type_e type)
+{
+    // a flag can't be positional, and the other types need more than a type to be declared
+    return type == OPTION_TYPE_INT || type == OPTION_TYPE_FLOAT || type == OPTION_TYPE_STRING ||
+           type == OPTION_TYPE_SIZE || type == OPTION_TYPE_DURATION;
+}
+
+bool positional_convert_(const positional_s* positional, const char* parameter, void* value)
+{
+    char* end = NULL;
+    switch (positional->type)
+    {
+    case OPTION_TYPE_INT:
+    {
+        errno = 0;
+        long number = strtol(parameter, &end, 10);
+        if (end == parameter || *end != '\0' || errno == ERANGE || number < INT_MIN || number > INT_MAX)
+            return false;
+
+        *(int*)value = (int)number;
+        return true;
+    }
+
+    case OPTION_TYPE_FLOAT:
+    {
+        errno = 0;
+        float number = strtof(parameter, &end);
+        if (end == parameter || *end != '\0' || errno == ERANGE)
+            return false;
+
+        *(float*)value = number;
+        return true;
+    }
+
+    case OPTION_TYPE_STRING:
+        *(const char**)value = parameter;
+        return true;
+
+    case OPTION_TYPE_SIZE:
+        return unit_suffix_parse_size(parameter, strlen(parameter), value);
+
+    case OPTION_TYPE_DURATION:
+        return unit_suffix_parse_duration(parameter, strlen(parameter), value);
+
+    default:
+        return false;
+    }
+}
+
+bool positional_in_range_(const positional_s* positional, size_t index, option_type_e type)
+{
+    return positional != NULL && positional->type == type && index < positional->value_count;
+}
+
+// END LOCAL IMPLEMENTATIONS //
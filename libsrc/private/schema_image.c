@@ -0,0 +1,750 @@
+#include "schema_image.h"
+
+#include "notation.h"
+#include "parse_stats.h"
+#include "extra/bitset.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// LOCAL DEFINITIONS //
+
+#define SCHEMA_IMAGE_MAGIC     0x53504143u /* "CAPS" */
+#define SCHEMA_IMAGE_VERSION   6u
+#define SCHEMA_IMAGE_ALIGNMENT 8u
+
+#define SCHEMA_IMAGE_OPTION_REQUIRED 1u
+
+typedef struct schema_image_header_
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t total_size;
+    uint32_t description;
+    uint32_t command_count;
+    uint32_t option_count;
+    uint32_t pointer_count; /**< the amount of string pointers needed for all the aliases, multi-string defaults and choices. */
+    uint32_t command_index_capacity;
+    uint32_t command_index;
+    uint32_t commands_offset;
+    uint32_t options_offset;
+    uint32_t choice_option_count; /**< the amount of options holding choices. */
+} schema_image_header_s;
+
+typedef struct schema_image_command_
+{
+    uint32_t name;
+    uint32_t description;
+    uint32_t alias_count;
+    uint32_t aliases;
+    uint32_t option_first;
+    uint32_t option_count;
+    uint32_t option_index_capacity;
+    uint32_t option_index;
+} schema_image_command_s;
+
+typedef struct schema_image_option_
+{
+    uint32_t name;
+    uint32_t description;
+    uint32_t alias_count;
+    uint32_t aliases;
+    uint32_t type;
+    uint32_t flags;
+    uint32_t repeat_policy;
+    uint32_t default_count;
+    uint64_t default_value; /**< the value itself for scalar types, a string offset or the offset of the string-offsets for text types. */
+    uint32_t choice_count;
+    uint32_t choice_names;      /**< the offset of the string-offsets of the choices. */
+    uint32_t choice_slot_count;
+    uint32_t choice_slots;      /**< the offset of the perfect hash slots, used in place once loaded. */
+    uint32_t choice_bucket_count;
+    uint32_t choice_displacements; /**< the offset of the perfect hash displacements, used in place once loaded. */
+} schema_image_option_s;
+
+/**
+ * Used twice while writing: first without `data_` to size up the sections, then to fill them in.
+ */
+typedef struct schema_image_writer_
+{
+    unsigned char* data_;
+    size_t words_cursor_;
+    size_t strings_cursor_;
+    size_t pointer_count_;
+    size_t choice_option_count_;
+    uint32_t description_;
+    uint32_t command_index_;
+} schema_image_writer_s;
+
+static size_t schema_image_align_(size_t offset);
+static void schema_image_write_sections_(schema_image_writer_s* writer, const command_tree_s* tree, size_t commands_offset, size_t options_offset);
+static uint32_t schema_image_put_string_(schema_image_writer_s* writer, const char* value);
+static uint32_t schema_image_put_strings_(schema_image_writer_s* writer, const char* const* values, size_t count);
+static uint32_t schema_image_put_words_(schema_image_writer_s* writer, const uint32_t* words, size_t count);
+
+static bool schema_image_fits_(size_t length, uint64_t offset, uint64_t size);
+static bool schema_image_index_valid_(const unsigned char* image, size_t length, uint32_t offset, size_t capacity, size_t entry_count);
+static const char* schema_image_string_(const unsigned char* image, size_t length, uint32_t offset, bool* is_valid);
+static char** schema_image_strings_(const unsigned char* image, size_t length, uint32_t offset, size_t count, char** pointers, bool* is_valid);
+static bool schema_image_load_(command_tree_s* tree, const void* image, size_t length);
+static bool schema_image_load_option_(option_s* option, notation_s* notation, int64_t* counter, char*** pointers,
+                                      const unsigned char* image, size_t length, const schema_image_option_s* record);
+static bool schema_image_load_choices_(option_choices_s* choices, char** pointers,
+                                       const unsigned char* image, size_t length, const schema_image_option_s* record);
+
+// END LOCAL DEFINITIONS //
+
+size_t schema_image_write(const command_tree_s* tree, void* buffer, size_t buffer_length)
+{
+    // the global options are not part of the image
+    if (tree == NULL || !tree->is_frozen || tree->globals.option_count > 0)
+        return 0;
+
+    size_t option_total = 0;
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        option_total += tree->commands[i].option_count;
+
+        // the image has no room for positionals or constraints, like it has none for the global options
+        if (tree->commands[i].positional_count > 0 || tree->commands[i].constraint_count > 0)
+            return 0;
+
+        // the functions of a user-defined type or a stream only exist within the running process
+        for (size_t j = 0; j < tree->commands[i].option_count; ++j)
+            if (tree->commands[i].options[j].type == OPTION_TYPE_CUSTOM || tree->commands[i].options[j].stream_callback != NULL)
+                return 0;
+    }
+
+    size_t commands_offset = schema_image_align_(sizeof(schema_image_header_s));
+    size_t options_offset = schema_image_align_(commands_offset + sizeof(schema_image_command_s) * tree->command_count);
+    size_t words_offset = schema_image_align_(options_offset + sizeof(schema_image_option_s) * option_total);
+
+    // first pass: size up the lookup-indices, string-offsets and string data
+    schema_image_writer_s measure = {0};
+    schema_image_write_sections_(&measure, tree, commands_offset, options_offset);
+
+    size_t strings_offset = words_offset + measure.words_cursor_;
+    size_t total_size = strings_offset + measure.strings_cursor_ + 1;
+
+    if (total_size > UINT32_MAX)
+        return 0;
+
+    if (buffer == NULL || buffer_length < total_size)
+        return total_size;
+
+    // second pass: write every section, the string data starts off with a NUL so offset 0 is never a string
+    unsigned char* data = buffer;
+    memset(data, 0, total_size);
+
+    schema_image_writer_s writer = {
+        .data_ = data,
+        .words_cursor_ = words_offset,
+        .strings_cursor_ = strings_offset + 1
+    };
+    schema_image_write_sections_(&writer, tree, commands_offset, options_offset);
+
+    schema_image_header_s header = {
+        .magic = SCHEMA_IMAGE_MAGIC,
+        .version = SCHEMA_IMAGE_VERSION,
+        .total_size = (uint32_t)total_size,
+        .description = writer.description_,
+        .command_count = (uint32_t)tree->command_count,
+        .option_count = (uint32_t)option_total,
+        .pointer_count = (uint32_t)writer.pointer_count_,
+        .choice_option_count = (uint32_t)writer.choice_option_count_,
+        .command_index_capacity = (uint32_t)tree->command_index_capacity,
+        .command_index = writer.command_index_,
+        .commands_offset = (uint32_t)commands_offset,
+        .options_offset = (uint32_t)options_offset
+    };
+    memcpy(data, &header, sizeof(header));
+
+    return total_size;
+}
+
+bool schema_image_save(const command_tree_s* tree, const char* path)
+{
+    if (path == NULL)
+        return false;
+
+    size_t size = schema_image_write(tree, NULL, 0);
+    if (size == 0)
+        return false;
+
+    void* image = malloc(size);
+    if (image == NULL)
+        return false;
+
+    bool success = schema_image_write(tree, image, size) == size;
+
+    FILE* file = success ? fopen(path, "wb") : NULL;
+    if (file != NULL)
+    {
+        success = fwrite(image, 1, size, file) == size;
+        success = fclose(file) == 0 && success;
+    }
+    else
+        success = false;
+
+    free(image);
+    return success;
+}
+
+bool command_tree_load_image(command_tree_s* tree, const void* image, size_t length)
+{
+    if (tree == NULL)
+        return false;
+
+    tree->stats = (parse_stats_s){0};
+    PARSE_STATS_BEGIN(&tree->stats, PARSE_STATS_PHASE_CONSTRUCTION);
+    bool result = schema_image_load_(tree, image, length);
+    PARSE_STATS_END();
+    return result;
+}
+
+bool command_tree_map_image(command_tree_s* tree, const char* path)
+{
+    if (tree == NULL || path == NULL)
+        return false;
+
+    const void* mapping = NULL;
+    size_t length = 0;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    HANDLE file_mapping = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+        file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (file_mapping != NULL)
+    {
+        mapping = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+        length = (size_t)file_size.QuadPart;
+        CloseHandle(file_mapping);
+    }
+    CloseHandle(file);
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0)
+    {
+        length = (size_t)file_stat.st_size;
+        mapping = mmap(NULL, length, PROT_READ, MAP_SHARED, file, 0);
+        if (mapping == MAP_FAILED)
+            mapping = NULL;
+    }
+    close(file);
+#endif
+
+    if (mapping == NULL)
+        return false;
+
+    if (!command_tree_load_image(tree, mapping, length))
+    {
+        schema_image_unmap(mapping, length);
+        return false;
+    }
+
+    tree->image_is_mapped = true;
+    tree->image_length = length;
+    return true;
+}
+
+void schema_image_unmap(const void* mapping, size_t length)
+{
+    if (mapping == NULL)
+        return;
+
+#if defined(_WIN32)
+    (void)length;
+    UnmapViewOfFile(mapping);
+#else
+    munmap((void*)mapping, length);
+#endif
+}
+
+// LOCAL IMPLEMENTATIONS //
+
+size_t schema_image_align_(size_t offset)
+{
+    return (offset + SCHEMA_IMAGE_ALIGNMENT - 1) / SCHEMA_IMAGE_ALIGNMENT * SCHEMA_IMAGE_ALIGNMENT;
+}
+
+void schema_image_write_sections_(schema_image_writer_s* writer, const command_tree_s* tree, size_t commands_offset, size_t options_offset)
+{
+    writer->description_ = schema_image_put_string_(writer, tree->description);
+    writer->command_index_ = schema_image_put_words_(writer, tree->command_index, tree->command_index_capacity * NOTATION_INDEX_LANES);
+
+    size_t option_position = 0;
+    for (size_t i = 0; i < tree->command_count; ++i)
+    {
+        const command_s* command = &tree->commands[i];
+        schema_image_command_s record = {
+            .name = schema_image_put_string_(writer, command->notation.main_name),
+            .description = schema_image_put_string_(writer, command->notation.description),
+            .alias_count = (uint32_t)command->notation.alias_count,
+            .aliases = schema_image_put_strings_(writer, (const char* const*)command->notation.aliases, command->notation.alias_count),
+            .option_first = (uint32_t)option_position,
+            .option_count = (uint32_t)command->option_count,
+            .option_index_capacity = (uint32_t)command->option_index_capacity,
+            .option_index = schema_image_put_words_(writer, command->option_index, command->option_index_capacity * NOTATION_INDEX_LANES)
+        };
+
+        if (writer->data_ != NULL)
+            memcpy(writer->data_ + commands_offset + sizeof(record) * i, &record, sizeof(record));
+
+        for (size_t j = 0; j < command->option_count; ++j, ++option_position)
+        {
+            const option_s* option = &command->options[j];
+            const notation_s* notation = shared_value_read_const(&option->shared_notation);
+
+            schema_image_option_s option_record = {
+                .name = schema_image_put_string_(writer, notation->main_name),
+                .description = schema_image_put_string_(writer, notation->description),
+                .alias_count = (uint32_t)notation->alias_count,
+                .aliases = schema_image_put_strings_(writer, (const char* const*)notation->aliases, notation->alias_count),
+                .type = (uint32_t)option->type,
+                .flags = option->is_required ? SCHEMA_IMAGE_OPTION_REQUIRED : 0,
+                .repeat_policy = (uint32_t)option->repeat_policy
+            };
+
+            switch (option->type)
+            {
+            case OPTION_TYPE_BOOL:
+                option_record.default_value = option->default_value.bool_value;
+            break;
+            case OPTION_TYPE_INT:
+                memcpy(&option_record.default_value, &option->default_value.int_value, sizeof(int));
+            break;
+            case OPTION_TYPE_FLOAT:
+                memcpy(&option_record.default_value, &option->default_value.float_value, sizeof(float));
+            break;
+            case OPTION_TYPE_SIZE:
+            case OPTION_TYPE_DURATION:
+                option_record.default_value = option->default_value.size_value;
+            break;
+            case OPTION_TYPE_STRING:
+                option_record.default_value = schema_image_put_string_(writer, option->default_value.string_value);
+            break;
+            case OPTION_TYPE_MULTI_STRING:
+            {
+                size_t count = 0;
+                if (option->default_value.multi_string_value != NULL)
+                    for (; option->default_value.multi_string_value[count] != NULL; ++count) {};
+
+                // the multi-string defaults get a NULL-terminator once loaded
+                option_record.default_count = (uint32_t)count;
+                writer->pointer_count_ += count > 0 ? 1 : 0;
+                option_record.default_value = schema_image_put_strings_(writer, (const char* const*)option->default_value.multi_string_value, count);
+            }
+            break;
+            case OPTION_TYPE_CHOICE:
+                memcpy(&option_record.default_value, &option->default_value.int_value, sizeof(int));
+                if (option->choices == NULL)
+                    break;
+
+                writer->choice_option_count_++;
+                option_record.choice_count = (uint32_t)option->choices->count;
+                option_record.choice_names = schema_image_put_strings_(writer, (const char* const*)option->choices->names, option->choices->count);
+                option_record.choice_slot_count = (uint32_t)option->choices->slot_count;
+                option_record.choice_slots = schema_image_put_words_(writer, option->choices->slots, option->choices->slot_count);
+                option_record.choice_bucket_count = (uint32_t)option->choices->bucket_count;
+                option_record.choice_displacements = schema_image_put_words_(writer, option->choices->displacements,
+                                                                             option->choices->bucket_count);
+            break;
+
+            default:
+            break;
+            }
+
+            if (writer->data_ != NULL)
+                memcpy(writer->data_ + options_offset + sizeof(option_record) * option_position, &option_record, sizeof(option_record));
+        }
+    }
+}
+
+uint32_t schema_image_put_string_(schema_image_writer_s* writer, const char* value)
+{
+    if (value == NULL)
+        return 0;
+
+    // every string is preceded by its length, the same layout as the string pool of a frozen tree
+    size_t length = strlen(value);
+    size_t offset = writer->strings_cursor_ + NOTATION_POOL_PREFIX_SIZE;
+    if (writer->data_ != NULL)
+    {
+        uint32_t prefix = (uint32_t)length;
+        memcpy(writer->data_ + writer->strings_cursor_, &prefix, sizeof(uint32_t));
+        memcpy(writer->data_ + offset, value, length + 1);
+    }
+
+    writer->strings_cursor_ += NOTATION_POOL_PREFIX_SIZE + length + 1;
+    return (uint32_t)offset;
+}
+
+uint32_t schema_image_put_strings_(schema_image_writer_s* writer, const char* const* values, size_t count)
+{
+    if (values == NULL || count == 0)
+        return 0;
+
+    size_t offset = writer->words_cursor_;
+    writer->words_cursor_ += sizeof(uint32_t) * count;
+    writer->pointer_count_ += count;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t string_offset = schema_image_put_string_(writer, values[i]);
+        if (writer->data_ != NULL)
+            memcpy(writer->data_ + offset + sizeof(uint32_t) * i, &string_offset, sizeof(uint32_t));
+    }
+
+    return (uint32_t)offset;
+}
+
+uint32_t schema_image_put_words_(schema_image_writer_s* writer, const uint32_t* words, size_t count)
+{
+    if (words == NULL || count == 0)
+        return 0;
+
+    size_t offset = writer->words_cursor_;
+    if (writer->data_ != NULL)
+        memcpy(writer->data_ + offset, words, sizeof(uint32_t) * count);
+
+    writer->words_cursor_ += sizeof(uint32_t) * count;
+
+    return (uint32_t)offset;
+}
+
+bool schema_image_fits_(size_t length, uint64_t offset, uint64_t size)
+{
+    return offset <= length && size <= length - offset;
+}
+
+bool schema_image_index_valid_(const unsigned char* image, size_t length, uint32_t offset, size_t capacity, size_t entry_count)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 || offset % sizeof(uint32_t) != 0 ||
+        !schema_image_fits_(length, offset, (uint64_t)sizeof(uint32_t) * capacity * NOTATION_INDEX_LANES))
+        return false;
+
+    // an entry past the commands or options would be followed without any further checks,
+    // and a probe only stops at an empty slot, so an index without one would never end
+    const uint32_t* slots = (const uint32_t*)(image + offset);
+    bool has_empty_slot = false;
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        if (slots[i] > entry_count)
+            return false;
+
+        has_empty_slot = has_empty_slot || slots[i] == 0;
+    }
+
+    return has_empty_slot;
+}
+
+const char* schema_image_string_(const unsigned char* image, size_t length, uint32_t offset, bool* is_valid)
+{
+    if (offset == 0)
+        return NULL;
+
+    // the image ends with a NUL, so every offset within it points at a terminated string
+    if (offset < NOTATION_POOL_PREFIX_SIZE || offset >= length)
+    {
+        *is_valid = false;
+        return NULL;
+    }
+
+    // the length prefix is trusted when comparing flags, so it may never reach past the image
+    uint32_t prefix = 0;
+    memcpy(&prefix, image + offset - NOTATION_POOL_PREFIX_SIZE, sizeof(uint32_t));
+    if (prefix >= length - offset)
+    {
+        *is_valid = false;
+        return NULL;
+    }
+
+    return (const char*)image + offset;
+}
+
+char** schema_image_strings_(const unsigned char* image, size_t length, uint32_t offset, size_t count, char** pointers, bool* is_valid)
+{
+    if (count == 0)
+        return NULL;
+
+    if (!schema_image_fits_(length, offset, (uint64_t)sizeof(uint32_t) * count))
+    {
+        *is_valid = false;
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t string_offset = 0;
+        memcpy(&string_offset, image + offset + sizeof(uint32_t) * i, sizeof(uint32_t));
+        pointers[i] = (char*)schema_image_string_(image, length, string_offset, is_valid);
+    }
+
+    return pointers;
+}
+
+bool schema_image_load_(command_tree_s* tree, const void* image, size_t length)
+{
+    if (image == NULL || length < sizeof(schema_image_header_s) ||
+        (uintptr_t)image % SCHEMA_IMAGE_ALIGNMENT != 0)
+        return false;
+
+    const unsigned char* data = image;
+    schema_image_header_s header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != SCHEMA_IMAGE_MAGIC || header.version != SCHEMA_IMAGE_VERSION ||
+        header.total_size < sizeof(schema_image_header_s) || header.total_size > length ||
+        data[header.total_size - 1] != '\0')
+        return false;
+
+    // a tree without commands is written as well, its image only holds an empty lookup-index
+    length = header.total_size;
+    if (!schema_image_fits_(length, header.commands_offset, (uint64_t)sizeof(schema_image_command_s) * header.command_count) ||
+        !schema_image_fits_(length, header.options_offset, (uint64_t)sizeof(schema_image_option_s) * header.option_count) ||
+        !schema_image_index_valid_(data, length, header.command_index, header.command_index_capacity, header.command_count))
+        return false;
+
+    size_t word_total = 0;
+    for (size_t i = 0; i < header.command_count; ++i)
+    {
+        schema_image_command_s record;
+        memcpy(&record, data + header.commands_offset + sizeof(record) * i, sizeof(record));
+        word_total += bitset_word_count(record.option_count) * 3;
+    }
+
+    // everything that can't live inside of the read-only image shares a single allocation
+    size_t options_offset = schema_image_align_(sizeof(command_s) * header.command_count);
+    size_t notations_offset = schema_image_align_(options_offset + sizeof(option_s) * header.option_count);
+    size_t counters_offset = schema_image_align_(notations_offset + sizeof(notation_s) * header.option_count);
+    size_t bits_offset = schema_image_align_(counters_offset + sizeof(int64_t) * header.option_count);
+    size_t choices_offset = schema_image_align_(bits_offset + sizeof(uint64_t) * word_total);
+    size_t pointers_offset = schema_image_align_(choices_offset + sizeof(option_choices_s) * header.choice_option_count);
+    size_t block_size = pointers_offset + sizeof(char*) * header.pointer_count;
+
+    unsigned char* block = block_size > 0 ? calloc(1, block_size) : NULL;
+    if (block == NULL && block_size > 0)
+        return false;
+
+    PARSE_STATS_ALLOCATION(block_size);
+
+    command_s* commands = (command_s*)block;
+    option_s* options = (option_s*)(block + options_offset);
+    notation_s* notations = (notation_s*)(block + notations_offset);
+    int64_t* counters = (int64_t*)(block + counters_offset);
+    uint64_t* bits = (uint64_t*)(block + bits_offset);
+    option_choices_s* choices = (option_choices_s*)(block + choices_offset);
+    option_choices_s* choices_end = choices + header.choice_option_count;
+    char** pointers = (char**)(block + pointers_offset);
+    char** pointers_end = pointers + header.pointer_count;
+
+    bool is_valid = true;
+    for (size_t i = 0; i < header.command_count && is_valid; ++i)
+    {
+        schema_image_command_s record;
+        memcpy(&record, data + header.commands_offset + sizeof(record) * i, sizeof(record));
+
+        command_s* command = &commands[i];
+        size_t word_count = bitset_word_count(record.option_count);
+
+        if ((uint64_t)record.option_first + record.option_count > header.option_count ||
+            pointers + record.alias_count > pointers_end ||
+            !schema_image_index_valid_(data, length, record.option_index, record.option_index_capacity, record.option_count))
+        {
+            is_valid = false;
+            break;
+        }
+
+        command->notation.main_name = (char*)schema_image_string_(data, length, record.name, &is_valid);
+        command->notation.description = (char*)schema_image_string_(data, length, record.description, &is_valid);
+        command->notation.alias_count = record.alias_count;
+        command->notation.aliases = schema_image_strings_(data, length, record.aliases, record.alias_count, pointers, &is_valid);
+        command->notation.is_interned = true;
+        notation_store_short_names(&command->notation);
+        pointers += record.alias_count;
+
+        command->is_frozen = true;
+        command->is_compacted = true;
+        command->is_loaded = true;
+        command->options = record.option_count > 0 ? &options[record.option_first] : NULL;
+        command->option_count = record.option_count;
+        command->option_capacity = record.option_count;
+        command->option_index_capacity = record.option_index_capacity;
+        command->option_index = (uint32_t*)(data + record.option_index);
+
+        command->option_word_count = word_count;
+        command->required_options = word_count > 0 ? bits : NULL;
+        command->present_options = word_count > 0 ? bits + word_count : NULL;
+        command->defaulted_options = word_count > 0 ? bits + word_count * 2 : NULL;
+        bits += word_count * 3;
+
+        for (size_t j = 0; j < record.option_count && is_valid; ++j)
+        {
+            size_t option_position = record.option_first + j;
+
+            schema_image_option_s option_record;
+            memcpy(&option_record, data + header.options_offset + sizeof(option_record) * option_position, sizeof(option_record));
+
+            size_t needed_pointers = option_record.alias_count + option_record.choice_count;
+            if (option_record.type == OPTION_TYPE_MULTI_STRING && option_record.default_count > 0)
+                needed_pointers += option_record.default_count + 1;
+
+            bool has_choices = option_record.type == OPTION_TYPE_CHOICE && option_record.choice_count > 0;
+            if (pointers + needed_pointers > pointers_end || (has_choices && choices == choices_end))
+            {
+                is_valid = false;
+                break;
+            }
+
+            is_valid = schema_image_load_option_(&options[option_position], &notations[option_position], &counters[option_position],
+                                                 &pointers, data, length, &option_record);
+
+            if (is_valid && has_choices)
+            {
+                is_valid = schema_image_load_choices_(choices, pointers, data, length, &option_record);
+                options[option_position].choices = choices++;
+                pointers += option_record.choice_count;
+            }
+
+            if (options[option_position].is_required)
+                bitset_set(command->required_options, j);
+        }
+    }
+
+    if (!is_valid)
+    {
+        free(block);
+        return false;
+    }
+
+    *tree = (command_tree_s){ .stats = tree->stats };
+    tree->is_frozen = true;
+    tree->commands = commands;
+    tree->command_count = header.command_count;
+    tree->command_capacity = header.command_count;
+    tree->command_block_size = block_size;
+    tree->command_index_capacity = header.command_index_capacity;
+    tree->command_index = (uint32_t*)(data + header.command_index);
+    tree->description = (char*)schema_image_string_(data, length, header.description, &is_valid);
+    tree->image = image;
+    tree->image_length = length;
+
+    return is_valid;
+}
+
+bool schema_image_load_option_(option_s* option, notation_s* notation, int64_t* counter, char*** pointers,
+                               const unsigned char* image, size_t length, const schema_image_option_s* record)
+{
+    bool is_valid = record->type < MAX_OPTION_TYPE_COUNT && record->type != OPTION_TYPE_CUSTOM && record->repeat_policy < MAX_OPTION_REPEAT_POLICY_COUNT;
+
+    notation->main_name = (char*)schema_image_string_(image, length, record->name, &is_valid);
+    notation->description = (char*)schema_image_string_(image, length, record->description, &is_valid);
+    notation->alias_count = record->alias_count;
+    notation->aliases = schema_image_strings_(image, length, record->aliases, record->alias_count, *pointers, &is_valid);
+    notation->is_interned = true;
+    notation_store_short_names(notation);
+    *pointers += record->alias_count;
+
+    // the use count never drops to zero, an image-backed option is never cleaned by `option_clean()`
+    *counter = 1;
+    option->shared_notation = (shared_value_s){
+        .value_mem_size_ = sizeof(notation_s),
+        .counter_ = counter,
+        .value_ = notation
+    };
+
+    option->type = (option_type_e)record->type;
+    option->is_required = (record->flags & SCHEMA_IMAGE_OPTION_REQUIRED) != 0;
+    option->repeat_policy = (option_repeat_policy_e)record->repeat_policy;
+
+    switch (option->type)
+    {
+    case OPTION_TYPE_BOOL:
+        option->default_value.bool_value = record->default_value != 0;
+    break;
+    case OPTION_TYPE_INT:
+        memcpy(&option->default_value.int_value, &record->default_value, sizeof(int));
+    break;
+    case OPTION_TYPE_FLOAT:
+        memcpy(&option->default_value.float_value, &record->default_value, sizeof(float));
+    break;
+    case OPTION_TYPE_SIZE:
+    case OPTION_TYPE_DURATION:
+        option->default_value.size_value = record->default_value;
+    break;
+    case OPTION_TYPE_STRING:
+        option->default_value.string_value = (char*)schema_image_string_(image, length, (uint32_t)record->default_value, &is_valid);
+    break;
+    case OPTION_TYPE_CHOICE:
+        memcpy(&option->default_value.int_value, &record->default_value, sizeof(int));
+    break;
+    case OPTION_TYPE_MULTI_STRING:
+        if (record->default_count == 0)
+            break;
+
+        option->default_value.multi_string_value = schema_image_strings_(image, length, (uint32_t)record->default_value,
+                                                                         record->default_count, *pointers, &is_valid);
+        (*pointers)[record->default_count] = NULL;
+        *pointers += record->default_count + 1;
+    break;
+
+    default:
+    break;
+    }
+
+    return is_valid;
+}
+
+bool schema_image_load_choices_(option_choices_s* choices, char** pointers,
+                                const unsigned char* image, size_t length, const schema_image_option_s* record)
+{
+    size_t slot_count = record->choice_slot_count;
+    size_t bucket_count = record->choice_bucket_count;
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0 ||
+        !schema_image_fits_(length, record->choice_slots, (uint64_t)sizeof(uint32_t) * slot_count) ||
+        record->choice_slots % sizeof(uint32_t) != 0)
+        return false;
+
+    // any displacement lands within the slots, so only the array itself needs checking
+    if (bucket_count == 0 || (bucket_count & (bucket_count - 1)) != 0 ||
+        !schema_image_fits_(length, record->choice_displacements, (uint64_t)sizeof(uint32_t) * bucket_count) ||
+        record->choice_displacements % sizeof(uint32_t) != 0)
+        return false;
+
+    bool is_valid = true;
+    choices->count = record->choice_count;
+    choices->names = schema_image_strings_(image, length, record->choice_names, record->choice_count, pointers, &is_valid);
+    choices->slot_count = slot_count;
+    choices->slots = (uint32_t*)(image + record->choice_slots);
+    choices->bucket_count = bucket_count;
+    choices->displacements = (uint32_t*)(image + record->choice_displacements);
+
+    // a slot pointing past the choices would be read without any further checks
+    for (size_t i = 0; i < slot_count && is_valid; ++i)
+        is_valid = choices->slots[i] <= choices->count;
+
+    return is_valid;
+}
+
+// END LOCAL IMPLEMENTATIONS //
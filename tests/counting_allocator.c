@@ -0,0 +1,73 @@
+#include "counting_allocator.h"
+
+// every block is preceded by the size it was requested with, padded to keep the block aligned for any type
+typedef union counting_header_
+{
+    size_t size;
+    max_align_t alignment_;
+} counting_header_u;
+
+static size_t live_bytes_ = 0;
+
+void* counting_malloc(size_t size)
+{
+    counting_header_u* header = malloc(sizeof(counting_header_u) + size);
+    if (header == NULL)
+        return NULL;
+
+    header->size = size;
+    live_bytes_ += size;
+    return header + 1;
+}
+
+void* counting_calloc(size_t count, size_t size)
+{
+    if (size != 0 && count > (size_t)-1 / size)
+        return NULL;
+
+    void* pointer = counting_malloc(count * size);
+    if (pointer != NULL)
+        memset(pointer, 0, count * size);
+
+    return pointer;
+}
+
+void* counting_realloc(void* pointer, size_t size)
+{
+    if (pointer == NULL)
+        return counting_malloc(size);
+
+    void* grown = counting_malloc(size);
+    if (grown == NULL)
+        return NULL;
+
+    size_t old_size = ((counting_header_u*)pointer - 1)->size;
+    memcpy(grown, pointer, old_size < size ? old_size : size);
+    counting_free(pointer);
+    return grown;
+}
+
+void counting_free(void* pointer)
+{
+    if (pointer == NULL)
+        return;
+
+    counting_header_u* header = (counting_header_u*)pointer - 1;
+    live_bytes_ -= header->size;
+    free(header);
+}
+
+char* counting_strdup(const char* string)
+{
+    size_t size = strlen(string) + 1;
+    char* copy = counting_malloc(size);
+    if (copy != NULL)
+        memcpy(copy, string, size);
+
+    return copy;
+}
+
+size_t counting_allocator_live_bytes(void)
+{
+    return live_bytes_;
+}
@@ -0,0 +1,33 @@
+#ifndef COMMAND_PARSER__COUNTING_ALLOCATOR_H__
+#define COMMAND_PARSER__COUNTING_ALLOCATOR_H__
+
+/*
+ * Force-included into every source of the library by the counting build of the tests, so each allocation the library
+ * makes goes through the functions below. The standard headers are included first, so their declarations are
+ * left untouched by the macros.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+void* counting_malloc(size_t size);
+void* counting_calloc(size_t count, size_t size);
+void* counting_realloc(void* pointer, size_t size);
+void counting_free(void* pointer);
+char* counting_strdup(const char* string);
+
+/**
+ * @brief The amount of bytes requested by all the allocations that haven't been freed yet.
+ */
+size_t counting_allocator_live_bytes(void);
+
+#if defined(COMMAND_PARSER_COUNTING_ALLOCATOR)
+#define malloc(size) counting_malloc(size)
+#define calloc(count, size) counting_calloc(count, size)
+#define realloc(pointer, size) counting_realloc(pointer, size)
+#define free(pointer) counting_free(pointer)
+#define strdup(string) counting_strdup(string)
+#endif // COMMAND_PARSER_COUNTING_ALLOCATOR
+
+#endif // !COMMAND_PARSER__COUNTING_ALLOCATOR_H__
@@ -0,0 +1,151 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <schema_image.h>
+#include <extra/perfect_hash.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LARGE_CHOICE_COUNT 5000
+
+static char** make_names_(size_t count)
+{
+    char** names = malloc(sizeof(char*) * count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        names[i] = malloc(32);
+        snprintf(names[i], 32, "choice-%zu", i);
+    }
+
+    return names;
+}
+
+static void free_names_(char** names, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        free(names[i]);
+
+    free(names);
+}
+
+static void check_perfect_hash_(size_t key_count)
+{
+    char** keys = make_names_(key_count);
+    size_t slot_count = perfect_hash_slot_count(key_count);
+    size_t bucket_count = perfect_hash_bucket_count(key_count);
+
+    // both arrays stay linear in the amount of keys
+    TEST_CHECK(slot_count <= 4 * key_count + 4);
+    TEST_CHECK(bucket_count <= key_count / 2 + 1);
+
+    uint32_t* slots = malloc(sizeof(uint32_t) * slot_count);
+    uint32_t* displacements = malloc(sizeof(uint32_t) * bucket_count);
+    TEST_CHECK(perfect_hash_build((const char* const*)keys, key_count, slots, slot_count, displacements, bucket_count));
+
+    // every key owns the slot it hashes to
+    for (size_t i = 0; i < key_count; ++i)
+    {
+        size_t slot = perfect_hash_slot(keys[i], strlen(keys[i]), displacements, bucket_count, slot_count);
+        TEST_CHECK(slots[slot] == i + 1);
+    }
+
+    free(displacements);
+    free(slots);
+    free_names_(keys, key_count);
+}
+
+static command_tree_s build_tree_(option_s* mode)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 0);
+    command_add_option(&run, mode);
+    command_tree_add_command(&tree, &run);
+
+    command_tree_freeze(&tree);
+    return tree;
+}
+
+static int parse_choice_(command_tree_s* tree, const char* value)
+{
+    const char* argv[] = { "program", "--run", "--mode", value };
+    const command_s* command = test_parse_(tree, 4, argv);
+    if (command == NULL || test_has_diagnostic_(command, DIAGNOSTIC_INVALID_VALUE))
+        return -1;
+
+    return command_read_choice_option(command, "--mode");
+}
+
+static void check_few_choices_(void)
+{
+    int default_choice = 0;
+    option_s mode = {0};
+    option_init(&mode, false, OPTION_TYPE_CHOICE, &default_choice);
+    option_set_name(&mode, "--mode", 0);
+    TEST_CHECK(!option_set_choices(&mode, 3, "safe", "fast", "safe"));
+    TEST_CHECK(option_set_choices(&mode, 3, "safe", "fast", "off"));
+
+    command_tree_s tree = build_tree_(&mode);
+    TEST_CHECK(parse_choice_(&tree, "safe") == 0);
+    TEST_CHECK(parse_choice_(&tree, "fast") == 1);
+    TEST_CHECK(parse_choice_(&tree, "off") == 2);
+    TEST_CHECK(parse_choice_(&tree, "of") == -1);
+    TEST_CHECK(parse_choice_(&tree, "") == -1);
+    TEST_CHECK(parse_choice_(&tree, "slow") == -1);
+
+    command_tree_clean(&tree);
+}
+
+static void check_many_choices_(void)
+{
+    char** names = make_names_(LARGE_CHOICE_COUNT);
+
+    int default_choice = 0;
+    option_s mode = {0};
+    option_init(&mode, false, OPTION_TYPE_CHOICE, &default_choice);
+    option_set_name(&mode, "--mode", 0);
+    TEST_CHECK(option_set_choice_array(&mode, LARGE_CHOICE_COUNT, (const char* const*)names));
+    if (mode.choices != NULL)
+        TEST_CHECK(mode.choices->slot_count <= 4 * LARGE_CHOICE_COUNT);
+
+    command_tree_s tree = build_tree_(&mode);
+    free_names_(names, LARGE_CHOICE_COUNT);
+
+    TEST_CHECK(parse_choice_(&tree, "choice-0") == 0);
+    TEST_CHECK(parse_choice_(&tree, "choice-1234") == 1234);
+    TEST_CHECK(parse_choice_(&tree, "choice-4999") == 4999);
+    TEST_CHECK(parse_choice_(&tree, "choice-5000") == -1);
+
+    // a loaded tree looks the choices up through the displacements stored in the image
+    size_t length = schema_image_write(&tree, NULL, 0);
+    void* image = malloc(length);
+    TEST_CHECK(length > 0 && schema_image_write(&tree, image, length) == length);
+    command_tree_clean(&tree);
+
+    command_tree_s loaded = {0};
+    TEST_CHECK(command_tree_load_image(&loaded, image, length));
+    TEST_CHECK(parse_choice_(&loaded, "choice-4321") == 4321);
+    TEST_CHECK(parse_choice_(&loaded, "choice-x") == -1);
+
+    command_tree_clean(&loaded);
+    free(image);
+}
+
+int main(void)
+{
+    check_perfect_hash_(1);
+    check_perfect_hash_(3);
+    check_perfect_hash_(100);
+    check_perfect_hash_(LARGE_CHOICE_COUNT);
+
+    check_few_choices_();
+    check_many_choices_();
+    return TEST_RESULT();
+}
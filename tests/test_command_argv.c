@@ -0,0 +1,199 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <command_argv.h>
+#include <option.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static void add_option_(command_s* command, option_s* option, const char* name, const char* alias,
+                        option_repeat_policy_e repeat_policy)
+{
+    if (alias != NULL)
+        option_set_name(option, name, 1, alias);
+    else
+        option_set_name(option, name, 0);
+
+    option_set_repeat_policy(option, repeat_policy);
+    command_add_option(command, option);
+}
+
+static command_tree_s build_tree_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s verbose = {0};
+    option_init(&verbose, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&verbose, "--verbose", 0);
+    command_tree_add_global_option(&tree, &verbose);
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 1, "-r");
+
+    option_s level = {0}, ratio = {0}, name = {0}, files = {0}, mode = {0}, limit = {0}, timeout = {0}, debug = {0};
+    option_init(&level, false, OPTION_TYPE_INT, NULL);
+    add_option_(&run, &level, "--level", "-l", OPTION_REPEAT_FIRST_WINS);
+    option_init(&ratio, false, OPTION_TYPE_FLOAT, NULL);
+    add_option_(&run, &ratio, "--ratio", NULL, OPTION_REPEAT_FIRST_WINS);
+    option_init(&name, false, OPTION_TYPE_STRING, NULL);
+    add_option_(&run, &name, "--name", NULL, OPTION_REPEAT_ACCUMULATE);
+    option_init(&files, false, OPTION_TYPE_MULTI_STRING, NULL);
+    add_option_(&run, &files, "--files", NULL, OPTION_REPEAT_FIRST_WINS);
+
+    int default_mode = 0;
+    option_init(&mode, false, OPTION_TYPE_CHOICE, &default_mode);
+    option_set_choices(&mode, 3, "safe", "fast", "off");
+    add_option_(&run, &mode, "--mode", NULL, OPTION_REPEAT_FIRST_WINS);
+
+    option_init(&limit, false, OPTION_TYPE_SIZE, NULL);
+    add_option_(&run, &limit, "--limit", NULL, OPTION_REPEAT_FIRST_WINS);
+    option_init(&timeout, false, OPTION_TYPE_DURATION, NULL);
+    add_option_(&run, &timeout, "--timeout", NULL, OPTION_REPEAT_FIRST_WINS);
+    option_init(&debug, false, OPTION_TYPE_BOOL, NULL);
+    add_option_(&run, &debug, "--debug", "-d", OPTION_REPEAT_COUNT);
+
+    command_add_positional(&run, "inputs", OPTION_TYPE_STRING, 0, POSITIONAL_UNBOUNDED);
+    command_tree_add_command(&tree, &run);
+
+    command_tree_freeze(&tree);
+    return tree;
+}
+
+// rebuilds the argv of **command**, checking the size query against the written array
+static char** write_argv_(const command_s* command, argv_names_e names, int* argc)
+{
+    size_t element_count = 0;
+    size_t size = command_write_argv(command, "program", names, NULL, 0, &element_count);
+    TEST_CHECK(size > sizeof(char*) * element_count);
+
+    // a buffer that is a byte short gets the size back and is left alone
+    char** too_small = malloc(size);
+    memset(too_small, 0x5A, size);
+    TEST_CHECK(command_write_argv(command, "program", names, too_small, size - 1, NULL) == size);
+    TEST_CHECK(((unsigned char*)too_small)[0] == 0x5A && ((unsigned char*)too_small)[size - 1] == 0x5A);
+    free(too_small);
+
+    char** argv = malloc(size);
+    size_t written_count = 0;
+    TEST_CHECK(command_write_argv(command, "program", names, argv, size, &written_count) == size);
+    TEST_CHECK(written_count == element_count);
+    TEST_CHECK(argv[written_count] == NULL);
+
+    *argc = (int)written_count;
+    return argv;
+}
+
+static void check_same_values_(const command_s* expected, const command_s* actual)
+{
+    TEST_CHECK(command_read_int_option(actual, "--level") == command_read_int_option(expected, "--level"));
+    TEST_CHECK(command_read_float_option(actual, "--ratio") == command_read_float_option(expected, "--ratio"));
+    TEST_CHECK(command_read_choice_option(actual, "--mode") == command_read_choice_option(expected, "--mode"));
+    TEST_CHECK(command_read_size_option(actual, "--limit") == command_read_size_option(expected, "--limit"));
+    TEST_CHECK(command_read_duration_option(actual, "--timeout") == command_read_duration_option(expected, "--timeout"));
+    TEST_CHECK(command_read_count_option(actual, "--debug") == command_read_count_option(expected, "--debug"));
+    TEST_CHECK(command_read_bool_option(actual, "--verbose") == command_read_bool_option(expected, "--verbose"));
+
+    size_t expected_count = 0, actual_count = 0;
+    const char** expected_names = command_read_string_list_option(expected, "--name", &expected_count);
+    const char** actual_names = command_read_string_list_option(actual, "--name", &actual_count);
+    TEST_CHECK(actual_count == expected_count);
+    for (size_t i = 0; i < actual_count && i < expected_count; ++i)
+        TEST_CHECK(strcmp(actual_names[i], expected_names[i]) == 0);
+
+    const char** expected_files = command_read_multi_string_option(expected, "--files", &expected_count);
+    const char** actual_files = command_read_multi_string_option(actual, "--files", &actual_count);
+    TEST_CHECK(actual_count == expected_count);
+    for (size_t i = 0; i < actual_count && i < expected_count; ++i)
+        TEST_CHECK(strcmp(actual_files[i], expected_files[i]) == 0);
+
+    TEST_CHECK(command_get_positional_count(actual, "inputs") == command_get_positional_count(expected, "inputs"));
+    for (size_t i = 0; i < command_get_positional_count(expected, "inputs"); ++i)
+    {
+        const char* actual_input = command_read_string_positional(actual, "inputs", i);
+        TEST_CHECK(actual_input != NULL && strcmp(actual_input, command_read_string_positional(expected, "inputs", i)) == 0);
+    }
+
+    size_t expected_tail = 0, actual_tail = 0;
+    const char* const* expected_passthrough = command_get_passthrough(expected, &expected_tail);
+    const char* const* actual_passthrough = command_get_passthrough(actual, &actual_tail);
+    TEST_CHECK(actual_tail == expected_tail);
+    for (size_t i = 0; i < actual_tail && i < expected_tail; ++i)
+        TEST_CHECK(strcmp(actual_passthrough[i], expected_passthrough[i]) == 0);
+}
+
+// parses the rebuilt argv with a tree of its own and compares every value
+static void check_round_trip_(const command_s* command, argv_names_e names)
+{
+    int argc = 0;
+    char** argv = write_argv_(command, names, &argc);
+
+    command_tree_s reparsed_tree = build_tree_();
+    const command_s* reparsed = test_parse_(&reparsed_tree, argc, (const char**)argv);
+    TEST_CHECK(reparsed != NULL);
+    if (reparsed != NULL)
+    {
+        TEST_CHECK(command_get_diagnostics(reparsed)->count == 0);
+        check_same_values_(command, reparsed);
+    }
+
+    command_tree_clean(&reparsed_tree);
+    free(argv);
+}
+
+static void check_as_passed_names_(const command_s* command)
+{
+    int argc = 0;
+    char** argv = write_argv_(command, ARGV_NAMES_AS_PASSED, &argc);
+    TEST_CHECK(argc > 2 && strcmp(argv[0], "program") == 0 && strcmp(argv[1], "-r") == 0);
+
+    bool has_alias = false;
+    for (int i = 0; i < argc; ++i)
+        has_alias = has_alias || strcmp(argv[i], "-l") == 0;
+    TEST_CHECK(has_alias);
+    free(argv);
+
+    argv = write_argv_(command, ARGV_NAMES_CANONICAL, &argc);
+    TEST_CHECK(argc > 1 && strcmp(argv[1], "--run") == 0);
+    free(argv);
+}
+
+int main(void)
+{
+    command_tree_s tree = build_tree_();
+
+    const char* argv[] = {
+        "program", "-r", "in1", "in2", "-l", "3", "--ratio", "0.1", "--name", "a", "--name", "b",
+        "--files", "x", "y", "--mode", "fast", "--limit", "4KiB", "--timeout", "1h30m",
+        "-d", "-d", "--verbose", "--", "tail", "--not-an-option"
+    };
+    command_s* command = test_parse_(&tree, (int)(sizeof(argv) / sizeof(*argv)), argv);
+    TEST_CHECK(command != NULL);
+    if (command != NULL)
+    {
+        TEST_CHECK(command_get_diagnostics(command)->count == 0);
+        check_round_trip_(command, ARGV_NAMES_CANONICAL);
+        check_round_trip_(command, ARGV_NAMES_AS_PASSED);
+        check_as_passed_names_(command);
+
+        // overridden values are formatted into the buffer, and read back exactly
+        int level = -42;
+        float ratio = 1.0f / 3.0f;
+        uint64_t limit = 123456789;
+        uint64_t timeout = 1500;
+        TEST_CHECK(command_set_option_value(command, "--level", &level));
+        TEST_CHECK(command_set_option_value(command, "--ratio", &ratio));
+        TEST_CHECK(command_set_option_value(command, "--limit", &limit));
+        TEST_CHECK(command_set_option_value(command, "--timeout", &timeout));
+        check_round_trip_(command, ARGV_NAMES_CANONICAL);
+    }
+
+    TEST_CHECK(command_write_argv(NULL, "program", ARGV_NAMES_CANONICAL, NULL, 0, NULL) == 0);
+    TEST_CHECK(command_write_argv(command, "program", MAX_ARGV_NAMES_COUNT, NULL, 0, NULL) == 0);
+
+    command_tree_clean(&tree);
+    return TEST_RESULT();
+}
@@ -0,0 +1,134 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+
+#include <diagnostics.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void add_bool_option_(command_s* command, const char* name)
+{
+    option_s option = {0};
+    option_init(&option, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&option, name, 0);
+    command_add_option(command, &option);
+}
+
+static command_tree_s build_tree_(bool freeze)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    command_s command = {0};
+    command_init(&command, 0);
+    command_set_name(&command, "--export", 0);
+    add_bool_option_(&command, "--json");
+    add_bool_option_(&command, "--yaml");
+    command_add_exclusive_group(&command, 2, "--json", "--yaml");
+
+    // enough options after the constraint to widen the option bitsets it was compiled against
+    for (int i = 0; i < 70; ++i)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "--extra%d", i);
+        add_bool_option_(&command, name);
+    }
+
+    add_bool_option_(&command, "--compress");
+    add_bool_option_(&command, "--level");
+    command_add_requirement(&command, "--level", 1, "--compress");
+    command_tree_add_command(&tree, &command);
+
+    if (freeze)
+        command_tree_freeze(&tree);
+
+    return tree;
+}
+
+static void check_constraints_(bool freeze)
+{
+    command_tree_s tree = build_tree_(freeze);
+
+    const char* exclusive[] = { "program", "--export", "--json", "--yaml" };
+    const command_s* command = test_parse_(&tree, 4, exclusive);
+    TEST_CHECK(command != NULL);
+    if (command != NULL)
+        TEST_CHECK(test_has_diagnostic_(command, DIAGNOSTIC_EXCLUSIVE_OPTIONS));
+
+    const char* dependency[] = { "program", "--export", "--level" };
+    command = test_parse_(&tree, 3, dependency);
+    TEST_CHECK(command != NULL);
+    if (command != NULL)
+    {
+        TEST_CHECK(test_has_diagnostic_(command, DIAGNOSTIC_MISSING_DEPENDENCY));
+        TEST_CHECK(!test_has_diagnostic_(command, DIAGNOSTIC_EXCLUSIVE_OPTIONS));
+    }
+
+    const char* valid[] = { "program", "--export", "--yaml", "--level", "--compress" };
+    command = test_parse_(&tree, 5, valid);
+    TEST_CHECK(command != NULL);
+    if (command != NULL)
+        TEST_CHECK(command_get_diagnostics(command)->count == 0);
+
+    command_tree_clean(&tree);
+}
+
+static const diagnostic_s* find_diagnostic_(const command_s* command, diagnostic_code_e code)
+{
+    const diagnostics_s* diagnostics = command_get_diagnostics(command);
+    for (size_t i = 0; i < diagnostics->count; ++i)
+        if (diagnostics->entries[i].code == code)
+            return &diagnostics->entries[i];
+
+    return NULL;
+}
+
+static void check_format_(void)
+{
+    command_tree_s tree = build_tree_(true);
+
+    const char* exclusive[] = { "program", "--export", "--json", "--yaml" };
+    const command_s* command = test_parse_(&tree, 4, exclusive);
+    const diagnostic_s* diagnostic = command != NULL ? find_diagnostic_(command, DIAGNOSTIC_EXCLUSIVE_OPTIONS) : NULL;
+    TEST_CHECK(diagnostic != NULL);
+    if (diagnostic == NULL)
+    {
+        command_tree_clean(&tree);
+        return;
+    }
+
+    // without a buffer the message is only measured
+    int length = diagnostic_format(diagnostic, NULL, 0);
+    TEST_CHECK(length > 0);
+
+    char* message = malloc((size_t)length + 1);
+    TEST_CHECK(diagnostic_format(diagnostic, message, (size_t)length + 1) == length);
+    TEST_CHECK(strlen(message) == (size_t)length);
+    TEST_CHECK(strstr(message, "`--json`, `--yaml`") != NULL);
+
+    // every buffer too small for the list still gets the full length back, and a terminated prefix of the message
+    char* truncated = malloc((size_t)length);
+    for (size_t buffer_length = 1; buffer_length <= (size_t)length; ++buffer_length)
+    {
+        memset(truncated, 'x', (size_t)length);
+        TEST_CHECK(diagnostic_format(diagnostic, truncated, buffer_length) == length);
+        TEST_CHECK(strlen(truncated) == buffer_length - 1);
+        TEST_CHECK(strncmp(truncated, message, buffer_length - 1) == 0);
+    }
+
+    free(truncated);
+    free(message);
+    command_tree_clean(&tree);
+}
+
+int main(void)
+{
+    check_format_();
+    check_constraints_(false);
+    check_constraints_(true);
+    return TEST_RESULT();
+}
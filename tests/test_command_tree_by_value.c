@@ -0,0 +1,89 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <parse_stats.h>
+
+#include <string.h>
+
+// builds the tree in a local and returns it by value, like `command_builder()` of the quickstart example does
+static command_tree_s build_tree_(bool freeze)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s bool_option = {0};
+    option_init(&bool_option, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&bool_option, "--bool-opt", 0);
+
+    command_s main_command = {0};
+    command_init(&main_command, 1);
+    command_set_name(&main_command, "--main", 0);
+    command_add_option(&main_command, &bool_option);
+    command_tree_add_command(&tree, &main_command);
+
+    option_s verbose_option = {0};
+    option_init(&verbose_option, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&verbose_option, "--verbose", 1, "-v");
+    command_tree_add_global_option(&tree, &verbose_option);
+
+    if (freeze)
+        command_tree_freeze(&tree);
+
+    return tree;
+}
+
+static void check_parse_(bool freeze)
+{
+    command_tree_s tree = build_tree_(freeze);
+
+    const char* argv[] = { "program", "--main", "--bool-opt", "-v" };
+    TEST_CHECK(command_tree_parse_base(&tree, 4, argv));
+
+    command_s* called_command = command_tree_get_called_command(&tree);
+    TEST_CHECK(called_command != NULL);
+    if (called_command != NULL)
+    {
+        TEST_CHECK(command_parse(called_command));
+        TEST_CHECK(command_read_bool_option(called_command, "--bool-opt"));
+        TEST_CHECK(command_read_bool_option(called_command, "--verbose"));
+        TEST_CHECK(command_is_option_present(called_command, "-v"));
+        TEST_CHECK(command_get_diagnostics(called_command)->count == 0);
+    }
+
+    // moving the tree after its base was parsed leaves the called command usable through the moved tree
+    command_tree_s moved_tree = tree;
+    memset(&tree, 0xA5, sizeof(tree));
+
+    called_command = command_tree_get_called_command(&moved_tree);
+    TEST_CHECK(called_command != NULL);
+    if (called_command != NULL)
+        TEST_CHECK(command_read_bool_option(called_command, "--verbose"));
+
+    // the statistics of the parse end up in the moved tree as well
+    command_tree_reset_stats(&moved_tree);
+    char line[] = "--main --verbose";
+    TEST_CHECK(command_tree_parse_line(&moved_tree, line, strlen(line)));
+
+    parse_stats_s stats = {0};
+    if (command_tree_get_stats(&moved_tree, &stats))
+        TEST_CHECK(stats.phase_calls[PARSE_STATS_PHASE_COMMAND_PARSE] == 1);
+
+    called_command = command_tree_get_called_command(&moved_tree);
+    TEST_CHECK(called_command != NULL);
+    if (called_command != NULL)
+    {
+        TEST_CHECK(!command_read_bool_option(called_command, "--bool-opt"));
+        TEST_CHECK(command_read_bool_option(called_command, "--verbose"));
+    }
+
+    command_tree_clean(&moved_tree);
+}
+
+int main(void)
+{
+    check_parse_(false);
+    check_parse_(true);
+    return TEST_RESULT();
+}
@@ -0,0 +1,66 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+
+static int run_handler_(const command_tree_s* tree, command_s* command, void* context)
+{
+    (void)tree;
+    (void)command;
+
+    int* call_count = context;
+    (*call_count)++;
+    return 7;
+}
+
+static command_tree_s build_tree_(int* call_count)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 0);
+
+    option_s limit = {0};
+    option_init(&limit, false, OPTION_TYPE_SIZE, NULL);
+    option_set_name(&limit, "--limit", 0);
+    command_add_option(&run, &limit);
+
+    command_set_handler(&run, run_handler_, call_count);
+    command_tree_add_command(&tree, &run);
+
+    command_tree_freeze(&tree);
+    return tree;
+}
+
+int main(void)
+{
+    int call_count = 0;
+    command_tree_s tree = build_tree_(&call_count);
+
+    const char* valid[] = { "program", "--run", "--limit", "4KiB" };
+    TEST_CHECK(command_tree_run(&tree, 4, valid) == 7);
+    TEST_CHECK(call_count == 1);
+
+    // a repeated option is only a warning, so the handler still runs
+    const char* repeated[] = { "program", "--run", "--limit", "4KiB", "--limit", "8KiB" };
+    TEST_CHECK(command_tree_run(&tree, 6, repeated) == 7);
+    TEST_CHECK(call_count == 2);
+
+    // errors keep the handler from running, the caller finds them in the called command
+    const char* unknown[] = { "program", "--run", "--bogus" };
+    TEST_CHECK(command_tree_run(&tree, 3, unknown) == COMMAND_TREE_RUN_FAILURE);
+    TEST_CHECK(call_count == 2);
+
+    const command_s* command = command_tree_get_called_command(&tree);
+    TEST_CHECK(command != NULL && test_has_diagnostic_(command, DIAGNOSTIC_UNKNOWN_OPTION));
+
+    const char* invalid[] = { "program", "--run", "--limit", "lots" };
+    TEST_CHECK(command_tree_run(&tree, 4, invalid) == COMMAND_TREE_RUN_FAILURE);
+    TEST_CHECK(call_count == 2);
+
+    command_tree_clean(&tree);
+    return TEST_RESULT();
+}
@@ -0,0 +1,59 @@
+#include "test_support.h"
+
+#include <extra/line_tokenizer.h>
+
+#include <string.h>
+
+static size_t tokenize_(char* line, const char** tokens, size_t token_capacity)
+{
+    return line_tokenize(line, strlen(line), tokens, token_capacity);
+}
+
+static void check_continuations_(void)
+{
+    const char* tokens[8] = {0};
+
+    char only_continuation[] = " \\\n ";
+    TEST_CHECK(tokenize_(only_continuation, tokens, 8) == 0);
+
+    char bare_continuation[] = "\\\n";
+    TEST_CHECK(tokenize_(bare_continuation, tokens, 8) == 0);
+
+    char between_tokens[] = "--run \\\n --verbose";
+    TEST_CHECK(tokenize_(between_tokens, tokens, 8) == 2);
+    TEST_CHECK(strcmp(tokens[0], "--run") == 0);
+    TEST_CHECK(strcmp(tokens[1], "--verbose") == 0);
+
+    // within a token the continuation is dropped and the token carries on
+    char within_token[] = "ab\\\ncd";
+    TEST_CHECK(tokenize_(within_token, tokens, 8) == 1);
+    TEST_CHECK(strcmp(tokens[0], "abcd") == 0);
+
+    char before_token[] = "\\\nab";
+    TEST_CHECK(tokenize_(before_token, tokens, 8) == 1);
+    TEST_CHECK(strcmp(tokens[0], "ab") == 0);
+}
+
+static void check_empty_tokens_(void)
+{
+    const char* tokens[8] = {0};
+
+    // an empty token only comes from quotes, never from what's around them
+    char quoted[] = " '' \\\n \"\" ";
+    TEST_CHECK(tokenize_(quoted, tokens, 8) == 2);
+    TEST_CHECK(tokens[0][0] == '\0');
+    TEST_CHECK(tokens[1][0] == '\0');
+
+    char blank[] = " \t\n ";
+    TEST_CHECK(tokenize_(blank, tokens, 8) == 0);
+
+    char trailing_backslash[] = "ab \\";
+    TEST_CHECK(tokenize_(trailing_backslash, tokens, 8) == LINE_TOKENIZE_ERROR);
+}
+
+int main(void)
+{
+    check_continuations_();
+    check_empty_tokens_();
+    return TEST_RESULT();
+}
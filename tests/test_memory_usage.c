@@ -0,0 +1,138 @@
+#include "test_support.h"
+#include "counting_allocator.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <memory_usage.h>
+#include <schema_image.h>
+
+#include <string.h>
+
+// the tree has to report exactly the bytes the library holds at that moment, as seen by the counting allocator
+static void check_usage_(const command_tree_s* tree, size_t baseline)
+{
+    memory_usage_s usage = {0};
+    TEST_CHECK(command_tree_memory_usage(tree, &usage));
+    TEST_CHECK(usage.total == counting_allocator_live_bytes() - baseline);
+}
+
+static void build_tree_(command_tree_s* tree)
+{
+    command_tree_init(tree, 1);
+    command_tree_set_description(tree, "Builds and runs");
+
+    option_s verbose = {0};
+    option_init(&verbose, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&verbose, "--verbose", 1, "-v");
+    option_set_description(&verbose, "Talks more");
+
+    option_s name = {0};
+    option_init(&name, false, OPTION_TYPE_STRING, "default");
+    option_set_name(&name, "--name", 0);
+
+    const char* default_files[] = { "a.txt", "b.txt", NULL };
+    option_s files = {0};
+    option_init(&files, false, OPTION_TYPE_MULTI_STRING, default_files);
+    option_set_name(&files, "--files", 0);
+
+    int default_mode = 0;
+    option_s mode = {0};
+    option_init(&mode, false, OPTION_TYPE_CHOICE, &default_mode);
+    option_set_name(&mode, "--mode", 0);
+    option_set_choices(&mode, 3, "safe", "fast", "off");
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 1, "-r");
+    command_set_description(&run, "Runs it");
+    command_add_option(&run, &verbose);
+    command_add_option(&run, &name);
+    command_add_option(&run, &files);
+    command_add_option(&run, &mode);
+    command_add_exclusive_group(&run, 2, "--name", "--files");
+
+    command_s build = {0};
+    command_init(&build, 0);
+    command_set_name(&build, "--build", 0);
+    command_add_option(&build, &name);
+    command_add_positional(&build, "targets", OPTION_TYPE_STRING, 0, POSITIONAL_UNBOUNDED);
+
+    command_tree_add_command(tree, &run);
+    command_tree_add_command(tree, &build);
+}
+
+static void check_tree_(void)
+{
+    size_t baseline = counting_allocator_live_bytes();
+    command_tree_s tree = {0};
+    build_tree_(&tree);
+    check_usage_(&tree, baseline);
+
+    option_s config = {0};
+    option_init(&config, false, OPTION_TYPE_STRING, "config.ini");
+    option_set_name(&config, "--config", 0);
+    command_tree_add_global_option(&tree, &config);
+    check_usage_(&tree, baseline);
+
+    TEST_CHECK(command_tree_freeze(&tree));
+    check_usage_(&tree, baseline);
+
+    const char* argv[] = { "program", "--run", "-v", "--files", "x", "y", "--mode", "fast", "--config", "z" };
+    TEST_CHECK(command_tree_parse_base(&tree, 10, argv));
+    TEST_CHECK(command_parse(command_tree_get_called_command(&tree)));
+    check_usage_(&tree, baseline);
+
+    char line[] = "--build --name 'a b' --name c first second";
+    TEST_CHECK(command_tree_parse_line(&tree, line, strlen(line)));
+    check_usage_(&tree, baseline);
+
+    command_tree_clean(&tree);
+    check_usage_(&tree, baseline);
+}
+
+static void check_image_(void)
+{
+    // the image can't hold positionals or constraints, so it gets a tree of its own
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s count = {0};
+    option_init(&count, false, OPTION_TYPE_INT, NULL);
+    option_set_name(&count, "--count", 1, "-c");
+
+    command_s run = {0};
+    command_init(&run, 1);
+    command_set_name(&run, "--run", 0);
+    command_add_option(&run, &count);
+    command_tree_add_command(&tree, &run);
+    TEST_CHECK(command_tree_freeze(&tree));
+
+    size_t length = schema_image_write(&tree, NULL, 0);
+    void* image = malloc(length);
+    TEST_CHECK(image != NULL && schema_image_write(&tree, image, length) == length);
+    command_tree_clean(&tree);
+    if (image == NULL)
+        return;
+
+    size_t baseline = counting_allocator_live_bytes();
+    command_tree_s loaded_tree = {0};
+    TEST_CHECK(command_tree_load_image(&loaded_tree, image, length));
+    check_usage_(&loaded_tree, baseline);
+
+    const char* argv[] = { "program", "--run", "--count", "3" };
+    TEST_CHECK(command_tree_parse_base(&loaded_tree, 4, argv));
+    TEST_CHECK(command_parse(command_tree_get_called_command(&loaded_tree)));
+    check_usage_(&loaded_tree, baseline);
+
+    command_tree_clean(&loaded_tree);
+    check_usage_(&loaded_tree, baseline);
+    free(image);
+}
+
+int main(void)
+{
+    check_tree_();
+    check_image_();
+    return TEST_RESULT();
+}
@@ -0,0 +1,227 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <option_stream.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_COLLECTED_COUNT 4096
+
+// copies of every value handed over, as the values themselves only live until the callback returns
+typedef struct collected_
+{
+    char* values[MAX_COLLECTED_COUNT];
+    size_t count;
+    size_t call_count;
+    size_t largest_chunk;
+    size_t stop_after; /**< the callback returns false once this many values were handed over, _0_ never stops. */
+} collected_s;
+
+static bool collect_(const option_s* option, const char* const* values, size_t value_count, void* context)
+{
+    (void)option;
+    collected_s* collected = context;
+    collected->call_count++;
+    if (value_count > collected->largest_chunk)
+        collected->largest_chunk = value_count;
+
+    for (size_t i = 0; i < value_count && collected->count < MAX_COLLECTED_COUNT; ++i)
+    {
+        size_t length = strlen(values[i]);
+        collected->values[collected->count] = malloc(length + 1);
+        memcpy(collected->values[collected->count++], values[i], length + 1);
+    }
+
+    return collected->stop_after == 0 || collected->count < collected->stop_after;
+}
+
+static void collected_clean_(collected_s* collected)
+{
+    for (size_t i = 0; i < collected->count; ++i)
+        free(collected->values[i]);
+
+    *collected = (collected_s){0};
+}
+
+// a record of **length** bytes whose content tells its index and position apart
+static char* make_record_(size_t index, size_t length)
+{
+    char* record = malloc(length + 1);
+    for (size_t i = 0; i < length; ++i)
+        record[i] = (char)('a' + (index + i) % 26);
+
+    record[length] = '\0';
+    return record;
+}
+
+static FILE* make_stream_(const char* data, size_t length)
+{
+    FILE* stream = tmpfile();
+    fwrite(data, 1, length, stream);
+    rewind(stream);
+    return stream;
+}
+
+// parses `--files` with **arguments** and streams its values from **stream** into **collected**
+static bool stream_files_(char delimiter, const char* const* arguments, size_t argument_count, FILE* stream,
+                          collected_s* collected, size_t* value_count)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s files = {0};
+    option_init(&files, false, OPTION_TYPE_MULTI_STRING, NULL);
+    option_set_name(&files, "--files", 0);
+    TEST_CHECK(option_set_stream(&files, delimiter, collect_, collected));
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 0);
+    command_add_option(&run, &files);
+    command_tree_add_command(&tree, &run);
+    command_tree_freeze(&tree);
+
+    const char* argv[8] = { "program", "--run", "--files" };
+    for (size_t i = 0; i < argument_count; ++i)
+        argv[3 + i] = arguments[i];
+
+    const command_s* command = test_parse_(&tree, (int)(3 + argument_count), argv);
+    TEST_CHECK(command != NULL && command_get_diagnostics(command)->count == 0);
+
+    bool success = command != NULL && command_stream_option(command, "--files", stream, value_count);
+    command_tree_clean(&tree);
+    return success;
+}
+
+static void check_lines_(void)
+{
+    // more values than fit in a single chunk, with carriage returns, empty lines and no trailing newline
+    const size_t line_count = 3000;
+    size_t capacity = line_count * 16;
+    char* data = malloc(capacity);
+    size_t length = 0;
+    for (size_t i = 0; i < line_count; ++i)
+        length += (size_t)snprintf(data + length, capacity - length, i % 3 == 0 ? "line-%zu\r\n\n" : "line-%zu\n", i);
+    length--;
+
+    FILE* stream = make_stream_(data, length);
+    collected_s collected = {0};
+    size_t value_count = 0;
+    const char* arguments[] = { "first", "-", "last" };
+    TEST_CHECK(stream_files_('\n', arguments, 3, stream, &collected, &value_count));
+
+    TEST_CHECK(value_count == line_count + 2 && collected.count == line_count + 2);
+    TEST_CHECK(collected.largest_chunk <= OPTION_STREAM_CHUNK_VALUES && collected.call_count >= 3);
+    TEST_CHECK(strcmp(collected.values[0], "first") == 0);
+    TEST_CHECK(strcmp(collected.values[collected.count - 1], "last") == 0);
+    for (size_t i = 0; i < line_count && i + 1 < collected.count; ++i)
+    {
+        char expected[32];
+        snprintf(expected, sizeof(expected), "line-%zu", i);
+        TEST_CHECK(strcmp(collected.values[i + 1], expected) == 0);
+    }
+
+    collected_clean_(&collected);
+    fclose(stream);
+    free(data);
+}
+
+// writes **record_count** records of **record_length** bytes followed by a single record of **last_length**
+static bool stream_records_(size_t record_count, size_t record_length, size_t last_length, bool ends_in_delimiter,
+                            collected_s* collected)
+{
+    size_t length = record_count * (record_length + 1) + last_length + 1;
+    char* data = malloc(length);
+    size_t offset = 0;
+    for (size_t i = 0; i <= record_count; ++i)
+    {
+        size_t current_length = i < record_count ? record_length : last_length;
+        char* record = make_record_(i, current_length);
+        memcpy(data + offset, record, current_length + 1);
+        offset += current_length + 1;
+        free(record);
+    }
+
+    FILE* stream = make_stream_(data, ends_in_delimiter ? length : length - 1);
+    const char* arguments[] = { "-" };
+    bool success = stream_files_('\0', arguments, 1, stream, collected, NULL);
+
+    fclose(stream);
+    free(data);
+    return success;
+}
+
+static bool record_is_(const collected_s* collected, size_t index, size_t length)
+{
+    if (index >= collected->count)
+        return false;
+
+    char* expected = make_record_(index, length);
+    bool is_equal = strcmp(collected->values[index], expected) == 0;
+    free(expected);
+    return is_equal;
+}
+
+static void check_records_(void)
+{
+    collected_s collected = {0};
+
+    // records straddling the end of the buffer are moved to its front instead of being cut in two
+    TEST_CHECK(stream_records_(20, 10000, 5, true, &collected));
+    TEST_CHECK(collected.count == 21 && collected.call_count > 1);
+    for (size_t i = 0; i < 20; ++i)
+        TEST_CHECK(record_is_(&collected, i, 10000));
+    TEST_CHECK(record_is_(&collected, 20, 5));
+    collected_clean_(&collected);
+
+    // a record that fills the whole buffer together with its terminator still fits, with or without its delimiter
+    TEST_CHECK(stream_records_(1, 3, OPTION_STREAM_CHUNK_SIZE - 1, true, &collected));
+    TEST_CHECK(collected.count == 2 && record_is_(&collected, 1, OPTION_STREAM_CHUNK_SIZE - 1));
+    collected_clean_(&collected);
+
+    TEST_CHECK(stream_records_(0, 0, OPTION_STREAM_CHUNK_SIZE - 1, false, &collected));
+    TEST_CHECK(collected.count == 1 && record_is_(&collected, 0, OPTION_STREAM_CHUNK_SIZE - 1));
+    collected_clean_(&collected);
+
+    // a longer record stops the reading, after handing over the records in front of it
+    TEST_CHECK(!stream_records_(3, 100, OPTION_STREAM_CHUNK_SIZE, true, &collected));
+    TEST_CHECK(collected.count == 3 && record_is_(&collected, 2, 100));
+    collected_clean_(&collected);
+
+    TEST_CHECK(!stream_records_(3, 100, 70000, false, &collected));
+    TEST_CHECK(collected.count == 3);
+    collected_clean_(&collected);
+
+    // the callback returning false stops the reading as well
+    collected.stop_after = 2;
+    TEST_CHECK(!stream_records_(5, 10, 10, true, &collected));
+    collected_clean_(&collected);
+}
+
+static void check_without_stream_(void)
+{
+    collected_s collected = {0};
+    size_t value_count = 0;
+
+    // values from argv don't need a stream, the marker does
+    const char* plain[] = { "a", "b" };
+    TEST_CHECK(stream_files_('\n', plain, 2, NULL, &collected, &value_count));
+    TEST_CHECK(value_count == 2 && collected.count == 2);
+    collected_clean_(&collected);
+
+    const char* marked[] = { "a", "-" };
+    TEST_CHECK(!stream_files_('\n', marked, 2, NULL, &collected, &value_count));
+    collected_clean_(&collected);
+}
+
+int main(void)
+{
+    check_lines_();
+    check_records_();
+    check_without_stream_();
+    return TEST_RESULT();
+}
@@ -0,0 +1,257 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <parse_iter.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_EVENT_COUNT 32
+
+static command_tree_s build_tree_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s verbose = {0};
+    option_init(&verbose, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&verbose, "--verbose", 0);
+    command_tree_add_global_option(&tree, &verbose);
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 0);
+
+    option_s level = {0}, name = {0}, files = {0}, debug = {0};
+    option_init(&level, false, OPTION_TYPE_INT, NULL);
+    option_set_name(&level, "--level", 1, "-l");
+    command_add_option(&run, &level);
+
+    option_init(&name, false, OPTION_TYPE_STRING, NULL);
+    option_set_name(&name, "--name", 0);
+    command_add_option(&run, &name);
+
+    option_init(&files, false, OPTION_TYPE_MULTI_STRING, NULL);
+    option_set_name(&files, "--files", 0);
+    command_add_option(&run, &files);
+
+    option_init(&debug, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&debug, "-d", 0);
+    option_set_repeat_policy(&debug, OPTION_REPEAT_COUNT);
+    command_add_option(&run, &debug);
+
+    command_add_positional(&run, "inputs", OPTION_TYPE_STRING, 0, POSITIONAL_UNBOUNDED);
+    command_tree_add_command(&tree, &run);
+
+    command_tree_freeze(&tree);
+    return tree;
+}
+
+static bool has_diagnostic_at_(const command_s* command, diagnostic_code_e code, size_t argv_index)
+{
+    const diagnostics_s* diagnostics = command_get_diagnostics(command);
+    for (size_t i = 0; i < diagnostics->count; ++i)
+        if (diagnostics->entries[i].code == code && diagnostics->entries[i].argv_index == argv_index)
+            return true;
+
+    return false;
+}
+
+static size_t count_diagnostics_(const command_s* command, diagnostic_code_e code)
+{
+    size_t count = 0;
+    const diagnostics_s* diagnostics = command_get_diagnostics(command);
+    for (size_t i = 0; i < diagnostics->count; ++i)
+        count += diagnostics->entries[i].code == code;
+
+    return count;
+}
+
+// checks every option of the command against the events yielded for it
+static void check_options_(const command_s* command, const parse_event_s* events, size_t event_count)
+{
+    for (size_t o = 0; o < command->option_count; ++o)
+    {
+        const option_s* option = command_get_option(command, o);
+        const char* flag = option_get_name(option);
+        const parse_event_s* first = NULL;
+        size_t occurrence_count = 0;
+        size_t value_count = 0;
+        bool is_first_occurrence = false;
+
+        for (size_t i = 0; i < event_count; ++i)
+        {
+            if (events[i].option != option || events[i].kind == PARSE_EVENT_MISSING_VALUE)
+            {
+                is_first_occurrence = false;
+                continue;
+            }
+
+            if (events[i].kind == PARSE_EVENT_OPTION)
+            {
+                // only the first occurrence counts, every later one was reported and skipped with its value
+                if (first != NULL && option->repeat_policy == OPTION_REPEAT_FIRST_WINS)
+                    TEST_CHECK(has_diagnostic_at_(command, DIAGNOSTIC_REPEATED_OPTION, events[i].argv_index));
+
+                is_first_occurrence = first == NULL;
+                first = first == NULL ? &events[i] : first;
+                occurrence_count++;
+                continue;
+            }
+
+            // the values of the first occurrence of a multi-string option, in the same order
+            if (!is_first_occurrence)
+                continue;
+
+            size_t string_count = 0;
+            const char** strings = command_read_multi_string_option(command, flag, &string_count);
+            TEST_CHECK(value_count < string_count && strcmp(strings[value_count], events[i].text) == 0);
+            value_count++;
+        }
+
+        TEST_CHECK(command_is_option_present(command, flag) == (first != NULL));
+        if (first == NULL)
+            continue;
+
+        switch (option->type)
+        {
+        case OPTION_TYPE_BOOL:
+            if (option->repeat_policy == OPTION_REPEAT_COUNT)
+                TEST_CHECK(command_read_count_option(command, flag) == occurrence_count);
+            else
+                TEST_CHECK(command_read_bool_option(command, flag));
+            break;
+
+        case OPTION_TYPE_INT:
+            TEST_CHECK(command_read_int_option(command, flag) == (first->value != NULL ? atoi(first->value) : 0));
+            break;
+
+        case OPTION_TYPE_STRING:
+            TEST_CHECK(first->value != NULL && strcmp(command_read_string_option(command, flag), first->value) == 0);
+            break;
+
+        case OPTION_TYPE_MULTI_STRING:
+        {
+            size_t string_count = 0;
+            command_read_multi_string_option(command, flag, &string_count);
+            TEST_CHECK(string_count == value_count);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+// parses **argv** with `command_parse()` and with an iterator, both have to come to the same conclusions
+static void check_agreement_(int argc, const char** argv)
+{
+    command_tree_s tree = build_tree_();
+    const command_s* command = test_parse_(&tree, argc, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+    {
+        command_tree_clean(&tree);
+        return;
+    }
+
+    // the iterator starts after the program and the name of the command, where the argv-indices of the diagnostics start as well
+    parse_iter_s iter = {0};
+    TEST_CHECK(parse_iter_init(&iter, command, argc - 2, argv + 2));
+
+    parse_event_s events[MAX_EVENT_COUNT] = {0};
+    size_t event_count = 0;
+    while (event_count < MAX_EVENT_COUNT && parse_iter_next(&iter, &events[event_count]))
+        event_count++;
+    TEST_CHECK(event_count < MAX_EVENT_COUNT);
+
+    size_t positional_count = 0, unknown_count = 0, missing_count = 0, passthrough_count = 0;
+    size_t expected_passthrough_count = 0;
+    const char* const* passthrough = command_get_passthrough(command, &expected_passthrough_count);
+
+    for (size_t i = 0; i < event_count; ++i)
+    {
+        const parse_event_s* event = &events[i];
+        TEST_CHECK(event->text == argv[2 + event->argv_index]);
+
+        switch (event->kind)
+        {
+        case PARSE_EVENT_POSITIONAL:
+        {
+            const char* input = command_read_string_positional(command, "inputs", positional_count++);
+            TEST_CHECK(input != NULL && strcmp(input, event->text) == 0);
+            break;
+        }
+
+        case PARSE_EVENT_UNKNOWN_FLAG:
+            TEST_CHECK(has_diagnostic_at_(command, DIAGNOSTIC_UNKNOWN_OPTION, event->argv_index));
+            unknown_count++;
+            break;
+
+        case PARSE_EVENT_MISSING_VALUE:
+            TEST_CHECK(has_diagnostic_at_(command, DIAGNOSTIC_INVALID_VALUE, event->argv_index));
+            missing_count++;
+            break;
+
+        case PARSE_EVENT_PASSTHROUGH:
+            TEST_CHECK(passthrough_count < expected_passthrough_count && passthrough[passthrough_count] == event->text);
+            passthrough_count++;
+            break;
+
+        case PARSE_EVENT_OPTION:
+            // a global option is looked up just like the options of the command itself
+            if (strcmp(option_get_name(event->option), "--verbose") == 0)
+                TEST_CHECK(command_read_bool_option(command, "--verbose"));
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    TEST_CHECK(command_get_positional_count(command, "inputs") == positional_count);
+    TEST_CHECK(count_diagnostics_(command, DIAGNOSTIC_UNKNOWN_OPTION) == unknown_count);
+    TEST_CHECK(count_diagnostics_(command, DIAGNOSTIC_INVALID_VALUE) == missing_count);
+    TEST_CHECK(passthrough_count == expected_passthrough_count);
+    check_options_(command, events, event_count);
+
+    command_tree_clean(&tree);
+}
+
+#define CHECK_AGREEMENT(...)                                    \
+    do                                                          \
+    {                                                           \
+        const char* argv_[] = { "program", "--run", __VA_ARGS__ }; \
+        check_agreement_((int)(sizeof(argv_) / sizeof(*argv_)), argv_); \
+    } while (0)
+
+int main(void)
+{
+    CHECK_AGREEMENT("in1", "--level", "1", "in2", "--name", "x", "-d", "--verbose", "-d", "in3");
+
+    // the repeated occurrence is yielded, `command_parse()` skips it together with its value
+    CHECK_AGREEMENT("-l", "1", "in1", "--level", "3", "in2", "--name", "x", "--name", "y", "in3");
+    CHECK_AGREEMENT("--files", "a", "b", "--files", "c", "d", "-d", "e");
+    CHECK_AGREEMENT("--files", "a", "b", "--level", "2", "c");
+
+    CHECK_AGREEMENT("--bogus", "in1", "-x", "--level", "2", "--other");
+    CHECK_AGREEMENT("in1", "--name");
+    CHECK_AGREEMENT("--files", "--level", "2", "in1");
+    CHECK_AGREEMENT("--level");
+
+    CHECK_AGREEMENT("in1", "--level", "4", "--", "--level", "5", "tail");
+    CHECK_AGREEMENT("--files", "a", "--", "b");
+    CHECK_AGREEMENT("--name", "--", "tail");
+    CHECK_AGREEMENT("--", "--");
+
+    // without any argument both end up empty
+    const char* argv[] = { "program", "--run" };
+    check_agreement_(2, argv);
+
+    parse_iter_s iter = {0};
+    TEST_CHECK(!parse_iter_init(&iter, NULL, 0, NULL));
+    return TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <parse_result.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static void add_option_(command_s* command, const char* name, option_type_e type)
+{
+    option_s option = {0};
+    option_init(&option, false, type, NULL);
+    option_set_name(&option, name, 0);
+    command_add_option(command, &option);
+}
+
+static command_tree_s build_tree_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s config = {0};
+    option_init(&config, false, OPTION_TYPE_STRING, NULL);
+    option_set_name(&config, "--config", 0);
+    command_tree_add_global_option(&tree, &config);
+
+    option_s verbose = {0};
+    option_init(&verbose, false, OPTION_TYPE_BOOL, NULL);
+    option_set_name(&verbose, "--verbose", 0);
+    command_tree_add_global_option(&tree, &verbose);
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 0);
+    add_option_(&run, "--level", OPTION_TYPE_INT);
+    command_tree_add_command(&tree, &run);
+
+    command_tree_freeze(&tree);
+    return tree;
+}
+
+// encodes the called command into a buffer of exactly the queried size
+static unsigned char* write_blob_(const command_tree_s* tree, const command_s* command, size_t* length)
+{
+    *length = parse_result_write(tree, command, NULL, 0);
+    TEST_CHECK(*length > 0);
+
+    unsigned char* blob = malloc(*length);
+    TEST_CHECK(parse_result_write(tree, command, blob, *length - 1) == *length);
+    TEST_CHECK(parse_result_write(tree, command, blob, *length) == *length);
+    return blob;
+}
+
+static void check_global_options_(void)
+{
+    command_tree_s tree = build_tree_();
+
+    const char* argv[] = { "program", "--run", "--level", "4", "--config", "x.cfg", "--verbose", "input" };
+    command_s* command = test_parse_(&tree, 8, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+    {
+        command_tree_clean(&tree);
+        return;
+    }
+
+    size_t length = 0;
+    unsigned char* blob = write_blob_(&tree, command, &length);
+
+    parse_result_view_s view;
+    TEST_CHECK(parse_result_view_init(&view, blob, length));
+    TEST_CHECK(parse_result_get_option_count(&view) == 1);
+    TEST_CHECK(parse_result_get_global_option_count(&view) == 2);
+    TEST_CHECK(parse_result_read_int(&view, 0) == 4);
+
+    // the global options follow the options of the command
+    TEST_CHECK(parse_result_is_option_present(&view, 1));
+    const char* config = parse_result_read_string(&view, 1);
+    TEST_CHECK(config != NULL && strcmp(config, "x.cfg") == 0);
+    TEST_CHECK(parse_result_read_bool(&view, 2));
+    TEST_CHECK(parse_result_get_option_type(&view, 3) == MAX_OPTION_TYPE_COUNT);
+
+    TEST_CHECK(parse_result_get_parameter_count(&view) == 1);
+    const char* parameter = parse_result_get_parameter(&view, 0);
+    TEST_CHECK(parameter != NULL && strcmp(parameter, "input") == 0);
+
+    free(blob);
+    command_tree_clean(&tree);
+}
+
+static void check_passthrough_(void)
+{
+    command_tree_s tree = build_tree_();
+
+    const char* argv[] = { "program", "--run", "--level", "2", "--", "make", "--jobs", "8" };
+    command_s* command = test_parse_(&tree, 8, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+    {
+        command_tree_clean(&tree);
+        return;
+    }
+
+    size_t length = 0;
+    unsigned char* blob = write_blob_(&tree, command, &length);
+
+    // the tail after `--` is carried as-is, next to the parameters rather than among them
+    parse_result_view_s view;
+    TEST_CHECK(parse_result_view_init(&view, blob, length));
+    TEST_CHECK(parse_result_read_int(&view, 0) == 2);
+    TEST_CHECK(parse_result_get_parameter_count(&view) == 0);
+    TEST_CHECK(parse_result_get_passthrough_count(&view) == 3);
+
+    const char* expected[] = { "make", "--jobs", "8" };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const char* argument = parse_result_get_passthrough(&view, i);
+        TEST_CHECK(argument != NULL && strcmp(argument, expected[i]) == 0);
+    }
+    TEST_CHECK(parse_result_get_passthrough(&view, 3) == NULL);
+
+    free(blob);
+    command_tree_clean(&tree);
+}
+
+int main(void)
+{
+    check_global_options_();
+    check_passthrough_();
+    return TEST_RESULT();
+}
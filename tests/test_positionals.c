@@ -0,0 +1,105 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+
+#include <string.h>
+
+static command_tree_s build_tree_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 2);
+
+    command_s copy = {0};
+    command_init(&copy, 0);
+    command_set_name(&copy, "--copy", 0);
+
+    option_s limit = {0};
+    option_init(&limit, false, OPTION_TYPE_SIZE, NULL);
+    option_set_name(&limit, "--limit", 0);
+    command_add_option(&copy, &limit);
+
+    command_add_positional(&copy, "source", OPTION_TYPE_STRING, 1, 1);
+    command_add_positional(&copy, "target", OPTION_TYPE_STRING, 0, 1);
+    command_tree_add_command(&tree, &copy);
+
+    // without any options, so the flags can't be told apart by looking them up
+    command_s remove = {0};
+    command_init(&remove, 0);
+    command_set_name(&remove, "--remove", 0);
+    command_add_positional(&remove, "path", OPTION_TYPE_STRING, 1, 1);
+    command_tree_add_command(&tree, &remove);
+
+    return tree;
+}
+
+static bool parameters_are_(const command_s* command, int expected_count, const char* const* expected)
+{
+    int parameter_count = 0;
+    const char** parameters = command_get_parameters(command, &parameter_count);
+    if (parameter_count != expected_count)
+        return false;
+
+    for (int i = 0; i < expected_count; ++i)
+        if (strcmp(parameters[i], expected[i]) != 0)
+            return false;
+
+    return true;
+}
+
+static void check_rejected_arguments_(command_tree_s* tree)
+{
+    const char* argv[] = { "program", "--copy", "a", "--bogus", "--limit", "lots", "b" };
+    const command_s* command = test_parse_(tree, 7, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+        return;
+
+    TEST_CHECK(test_has_diagnostic_(command, DIAGNOSTIC_UNKNOWN_OPTION));
+    TEST_CHECK(test_has_diagnostic_(command, DIAGNOSTIC_INVALID_VALUE));
+    TEST_CHECK(!test_has_diagnostic_(command, DIAGNOSTIC_EXTRA_POSITIONAL));
+
+    TEST_CHECK(command_get_positional_count(command, "source") == 1);
+    TEST_CHECK(command_get_positional_count(command, "target") == 1);
+    const char* source = command_read_string_positional(command, "source", 0);
+    const char* target = command_read_string_positional(command, "target", 0);
+    TEST_CHECK(source != NULL && strcmp(source, "a") == 0);
+    TEST_CHECK(target != NULL && strcmp(target, "b") == 0);
+
+    // the excluded arguments are still parameters, after the ones the positionals took
+    const char* expected[] = { "a", "b", "--bogus", "lots" };
+    TEST_CHECK(parameters_are_(command, 4, expected));
+}
+
+static void check_command_without_options_(command_tree_s* tree)
+{
+    const char* argv[] = { "program", "--remove", "--force", "file" };
+    const command_s* command = test_parse_(tree, 4, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+        return;
+
+    TEST_CHECK(test_has_diagnostic_(command, DIAGNOSTIC_UNKNOWN_OPTION));
+    TEST_CHECK(!test_has_diagnostic_(command, DIAGNOSTIC_EXTRA_POSITIONAL));
+
+    const char* path = command_read_string_positional(command, "path", 0);
+    TEST_CHECK(path != NULL && strcmp(path, "file") == 0);
+
+    const char* expected[] = { "file", "--force" };
+    TEST_CHECK(parameters_are_(command, 2, expected));
+}
+
+int main(void)
+{
+    command_tree_s tree = build_tree_();
+    check_rejected_arguments_(&tree);
+    check_command_without_options_(&tree);
+
+    command_tree_freeze(&tree);
+    check_rejected_arguments_(&tree);
+    check_command_without_options_(&tree);
+
+    command_tree_clean(&tree);
+    return TEST_RESULT();
+}
@@ -0,0 +1,100 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+
+#include <string.h>
+
+static void add_option_(command_s* command, const char* name, option_type_e type, option_repeat_policy_e repeat_policy)
+{
+    option_s option = {0};
+    option_init(&option, false, type, NULL);
+    option_set_name(&option, name, 0);
+    option_set_repeat_policy(&option, repeat_policy);
+    command_add_option(command, &option);
+}
+
+static command_tree_s build_tree_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    command_s run = {0};
+    command_init(&run, 0);
+    command_set_name(&run, "--run", 0);
+    add_option_(&run, "--level", OPTION_TYPE_INT, OPTION_REPEAT_FIRST_WINS);
+    add_option_(&run, "--files", OPTION_TYPE_MULTI_STRING, OPTION_REPEAT_FIRST_WINS);
+    add_option_(&run, "--verbose", OPTION_TYPE_BOOL, OPTION_REPEAT_COUNT);
+    command_add_positional(&run, "count", OPTION_TYPE_INT, 0, 1);
+    command_tree_add_command(&tree, &run);
+
+    command_tree_freeze(&tree);
+    return tree;
+}
+
+static void check_first_wins_(command_tree_s* tree)
+{
+    const char* argv[] = { "program", "--run", "--level", "1", "--level", "3" };
+    const command_s* command = test_parse_(tree, 6, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+        return;
+
+    TEST_CHECK(command_read_int_option(command, "--level") == 1);
+    TEST_CHECK(test_has_diagnostic_(command, DIAGNOSTIC_REPEATED_OPTION));
+    TEST_CHECK(!test_has_diagnostic_(command, DIAGNOSTIC_EXTRA_POSITIONAL));
+
+    // the value of the ignored occurrence is neither a parameter nor a positional
+    int parameter_count = -1;
+    command_get_parameters(command, &parameter_count);
+    TEST_CHECK(parameter_count == 0);
+    TEST_CHECK(command_get_positional_count(command, "count") == 0);
+}
+
+static void check_first_wins_multi_string_(command_tree_s* tree)
+{
+    const char* argv[] = { "program", "--run", "--files", "a", "b", "--files", "c", "d", "7" };
+    const command_s* command = test_parse_(tree, 9, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+        return;
+
+    size_t file_count = 0;
+    const char** files = command_read_multi_string_option(command, "--files", &file_count);
+    TEST_CHECK(file_count == 2);
+    if (file_count == 2)
+        TEST_CHECK(strcmp(files[0], "a") == 0 && strcmp(files[1], "b") == 0);
+
+    // like the first occurrence, the ignored one takes every value up to the next flag
+    int parameter_count = -1;
+    command_get_parameters(command, &parameter_count);
+    TEST_CHECK(parameter_count == 0);
+    TEST_CHECK(command_get_positional_count(command, "count") == 0);
+}
+
+static void check_count_(command_tree_s* tree)
+{
+    const char* argv[] = { "program", "--run", "--verbose", "--verbose", "5", "--verbose" };
+    const command_s* command = test_parse_(tree, 6, argv);
+    TEST_CHECK(command != NULL);
+    if (command == NULL)
+        return;
+
+    // a counted flag never takes a value, so what follows it is still a positional
+    TEST_CHECK(command_read_count_option(command, "--verbose") == 3);
+    TEST_CHECK(command_get_positional_count(command, "count") == 1);
+    TEST_CHECK(command_read_int_positional(command, "count", 0) == 5);
+    TEST_CHECK(command_get_diagnostics(command)->count == 0);
+}
+
+int main(void)
+{
+    command_tree_s tree = build_tree_();
+    check_first_wins_(&tree);
+    check_first_wins_multi_string_(&tree);
+    check_count_(&tree);
+
+    command_tree_clean(&tree);
+    return TEST_RESULT();
+}
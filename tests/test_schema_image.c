@@ -0,0 +1,153 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+#include <schema_image.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the offsets of the header and command record fields within an image, see `schema_image.c`
+#define HEADER_TOTAL_SIZE     8
+#define HEADER_COMMAND_COUNT  16
+#define HEADER_INDEX_CAPACITY 28
+#define HEADER_INDEX          32
+#define HEADER_COMMANDS       36
+#define COMMAND_INDEX_CAPACITY 24
+#define COMMAND_INDEX          28
+
+static uint32_t read_word_(const unsigned char* image, size_t offset)
+{
+    uint32_t word = 0;
+    memcpy(&word, image + offset, sizeof(word));
+    return word;
+}
+
+static void write_word_(unsigned char* image, size_t offset, uint32_t word)
+{
+    memcpy(image + offset, &word, sizeof(word));
+}
+
+static unsigned char* write_image_(const command_tree_s* tree, size_t* length)
+{
+    *length = schema_image_write(tree, NULL, 0);
+    if (*length == 0)
+        return NULL;
+
+    // malloc aligns for any type, which covers the 8 bytes an image needs
+    unsigned char* image = malloc(*length);
+    if (image != NULL && schema_image_write(tree, image, *length) != *length)
+    {
+        free(image);
+        return NULL;
+    }
+
+    return image;
+}
+
+static bool loads_(const unsigned char* image, size_t length)
+{
+    command_tree_s tree = {0};
+    bool is_loaded = command_tree_load_image(&tree, image, length);
+    if (is_loaded)
+        command_tree_clean(&tree);
+
+    return is_loaded;
+}
+
+static void check_empty_tree_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 0);
+    TEST_CHECK(command_tree_freeze(&tree));
+
+    size_t length = 0;
+    unsigned char* image = write_image_(&tree, &length);
+    command_tree_clean(&tree);
+    TEST_CHECK(image != NULL);
+    if (image == NULL)
+        return;
+
+    command_tree_s loaded_tree = {0};
+    TEST_CHECK(command_tree_load_image(&loaded_tree, image, length));
+
+    const char* argv[] = { "program", "--anything" };
+    TEST_CHECK(!command_tree_parse_base(&loaded_tree, 2, argv));
+    command_tree_clean(&loaded_tree);
+    free(image);
+}
+
+static void check_corrupt_images_(void)
+{
+    command_tree_s tree = {0};
+    command_tree_init(&tree, 1);
+
+    option_s option = {0};
+    option_init(&option, false, OPTION_TYPE_INT, NULL);
+    option_set_name(&option, "--count", 0);
+
+    command_s command = {0};
+    command_init(&command, 1);
+    command_set_name(&command, "--run", 0);
+    command_add_option(&command, &option);
+    command_tree_add_command(&tree, &command);
+    TEST_CHECK(command_tree_freeze(&tree));
+
+    size_t length = 0;
+    unsigned char* image = write_image_(&tree, &length);
+    command_tree_clean(&tree);
+    TEST_CHECK(image != NULL);
+    if (image == NULL)
+        return;
+
+    TEST_CHECK(loads_(image, length));
+
+    unsigned char* corrupt = malloc(length);
+    if (corrupt == NULL)
+    {
+        free(image);
+        return;
+    }
+
+    // a total size of zero may not be used to find the terminating NUL
+    memcpy(corrupt, image, length);
+    write_word_(corrupt, HEADER_TOTAL_SIZE, 0);
+    TEST_CHECK(!loads_(corrupt, length));
+
+    // a slot of the command index pointing past the commands
+    size_t command_index = read_word_(image, HEADER_INDEX);
+    size_t command_index_capacity = read_word_(image, HEADER_INDEX_CAPACITY);
+    memcpy(corrupt, image, length);
+    write_word_(corrupt, command_index, read_word_(image, HEADER_COMMAND_COUNT) + 1);
+    TEST_CHECK(!loads_(corrupt, length));
+
+    // a command index without an empty slot, every slot pointing at the only command
+    memcpy(corrupt, image, length);
+    for (size_t i = 0; i < command_index_capacity; ++i)
+        write_word_(corrupt, command_index + sizeof(uint32_t) * i, 1);
+    TEST_CHECK(!loads_(corrupt, length));
+
+    // a slot of the option index pointing past the options of the command
+    size_t commands = read_word_(image, HEADER_COMMANDS);
+    size_t option_index = read_word_(image, commands + COMMAND_INDEX);
+    memcpy(corrupt, image, length);
+    write_word_(corrupt, option_index, 2);
+    TEST_CHECK(!loads_(corrupt, length));
+
+    // an option index whose capacity isn't a power of two
+    memcpy(corrupt, image, length);
+    write_word_(corrupt, commands + COMMAND_INDEX_CAPACITY, read_word_(image, commands + COMMAND_INDEX_CAPACITY) - 1);
+    TEST_CHECK(!loads_(corrupt, length));
+
+    free(corrupt);
+    free(image);
+}
+
+int main(void)
+{
+    check_empty_tree_();
+    check_corrupt_images_();
+    return TEST_RESULT();
+}
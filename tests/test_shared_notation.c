@@ -0,0 +1,59 @@
+#include "test_support.h"
+
+#include <command_tree.h>
+#include <command.h>
+#include <option.h>
+
+#include <string.h>
+
+static void add_command_(command_tree_s* tree, const char* name, option_s* option)
+{
+    command_s command = {0};
+    command_init(&command, 1);
+    command_set_name(&command, name, 0);
+    command_add_option(&command, option);
+    command_tree_add_command(tree, &command);
+}
+
+int main(void)
+{
+    // the same option, and with it the same notation, ends up in two trees
+    option_s shared_option = {0};
+    option_init(&shared_option, false, OPTION_TYPE_INT, NULL);
+    // a name too long to be kept inline in the notation, so matching it reads the pooled strings
+    option_set_name(&shared_option, "--repetition-count", 1, "-c");
+    option_set_description(&shared_option, "How many times");
+
+    command_tree_s first_tree = {0};
+    command_tree_init(&first_tree, 1);
+    add_command_(&first_tree, "--first", &shared_option);
+
+    command_tree_s second_tree = {0};
+    command_tree_init(&second_tree, 1);
+    add_command_(&second_tree, "--second", &shared_option);
+
+    TEST_CHECK(command_tree_freeze(&first_tree));
+    TEST_CHECK(command_tree_freeze(&second_tree));
+
+    // the second tree keeps using the notation after the pool of the first tree is gone
+    command_tree_clean(&first_tree);
+
+    const char* argv[] = { "program", "--second", "-c", "3" };
+    TEST_CHECK(command_tree_parse_base(&second_tree, 4, argv));
+
+    command_s* command = command_tree_get_called_command(&second_tree);
+    TEST_CHECK(command != NULL);
+    if (command != NULL)
+    {
+        TEST_CHECK(command_parse(command));
+        TEST_CHECK(command_read_int_option(command, "--repetition-count") == 3);
+
+        const option_s* option = command_find_option(command, "-c");
+        TEST_CHECK(option != NULL);
+        if (option != NULL)
+            TEST_CHECK(strcmp(option_get_description(option), "How many times") == 0);
+    }
+
+    command_tree_clean(&second_tree);
+    return TEST_RESULT();
+}
@@ -0,0 +1,48 @@
+#ifndef COMMAND_PARSER__TEST_SUPPORT_H__
+#define COMMAND_PARSER__TEST_SUPPORT_H__
+
+#include <command_tree.h>
+#include <command.h>
+
+#include <stdio.h>
+
+// counts the failed checks instead of stopping at the first one, so a single run reports all of them
+static int test_failures_ = 0;
+
+#define TEST_CHECK(condition)                                                       \
+    do                                                                              \
+    {                                                                               \
+        if (!(condition))                                                           \
+        {                                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            test_failures_++;                                                       \
+        }                                                                           \
+    } while (0)
+
+#define TEST_RESULT() (test_failures_ == 0 ? 0 : 1)
+
+// inline, so a test that doesn't use one of these doesn't get a warning for it
+static inline bool test_has_diagnostic_(const command_s* command, diagnostic_code_e code)
+{
+    const diagnostics_s* diagnostics = command_get_diagnostics(command);
+    for (size_t i = 0; i < diagnostics->count; ++i)
+        if (diagnostics->entries[i].code == code)
+            return true;
+
+    return false;
+}
+
+// parses the base of **argv** and then the command it calls, `NULL` when either fails
+static inline command_s* test_parse_(command_tree_s* tree, int argc, const char** argv)
+{
+    if (!command_tree_parse_base(tree, argc, argv))
+        return NULL;
+
+    command_s* command = command_tree_get_called_command(tree);
+    if (command == NULL || !command_parse(command))
+        return NULL;
+
+    return command;
+}
+
+#endif // !COMMAND_PARSER__TEST_SUPPORT_H__
@@ -0,0 +1,92 @@
+#include "test_support.h"
+
+#include <extra/unit_suffix.h>
+
+#include <string.h>
+
+static bool size_is_(const char* text, uint64_t expected)
+{
+    uint64_t bytes = 0;
+    return unit_suffix_parse_size(text, strlen(text), &bytes) && bytes == expected;
+}
+
+static bool size_fails_(const char* text)
+{
+    uint64_t bytes = 0;
+    return !unit_suffix_parse_size(text, strlen(text), &bytes);
+}
+
+static bool duration_is_(const char* text, uint64_t expected)
+{
+    uint64_t nanoseconds = 0;
+    return unit_suffix_parse_duration(text, strlen(text), &nanoseconds) && nanoseconds == expected;
+}
+
+static bool duration_fails_(const char* text)
+{
+    uint64_t nanoseconds = 0;
+    return !unit_suffix_parse_duration(text, strlen(text), &nanoseconds);
+}
+
+static void check_sizes_(void)
+{
+    TEST_CHECK(size_is_("0", 0));
+    TEST_CHECK(size_is_("512", 512));
+    TEST_CHECK(size_is_("512B", 512));
+    TEST_CHECK(size_is_("4kB", 4000));
+    TEST_CHECK(size_is_("4KB", 4000));
+    TEST_CHECK(size_is_("4KiB", 4096));
+    TEST_CHECK(size_is_("512MiB", 512ULL << 20));
+    TEST_CHECK(size_is_("15EiB", 15ULL << 60));
+    TEST_CHECK(size_is_("18EB", 18ULL * 1000 * 1000 * 1000 * 1000 * 1000 * 1000));
+    TEST_CHECK(size_is_("18446744073709551615", UINT64_MAX));
+
+    // whatever doesn't fit in 64 bits is rejected instead of wrapping around
+    TEST_CHECK(size_fails_("18446744073709551616"));
+    TEST_CHECK(size_fails_("16EiB"));
+    TEST_CHECK(size_fails_("19EB"));
+
+    TEST_CHECK(size_fails_(""));
+    TEST_CHECK(size_fails_("MiB"));
+    TEST_CHECK(size_fails_("-1"));
+    TEST_CHECK(size_fails_("4kb"));
+    TEST_CHECK(size_fails_("4 KiB"));
+    TEST_CHECK(size_fails_("4KiB4"));
+}
+
+static void check_durations_(void)
+{
+    const uint64_t second = 1000ULL * 1000 * 1000;
+
+    TEST_CHECK(duration_is_("0", 0));
+    TEST_CHECK(duration_is_("15ns", 15));
+    TEST_CHECK(duration_is_("250us", 250ULL * 1000));
+    TEST_CHECK(duration_is_("250ms", 250ULL * 1000 * 1000));
+    TEST_CHECK(duration_is_("90s", 90 * second));
+
+    // the parts of a compound duration add up, in any order
+    TEST_CHECK(duration_is_("1h30m", 90 * 60 * second));
+    TEST_CHECK(duration_is_("1m30s500ms", 90 * second + 500ULL * 1000 * 1000));
+    TEST_CHECK(duration_is_("30m1h", 90 * 60 * second));
+    TEST_CHECK(duration_is_("5124095h", 5124095ULL * 3600 * second));
+
+    // a single part or the sum of the parts overflowing is rejected
+    TEST_CHECK(duration_fails_("5124096h"));
+    TEST_CHECK(duration_fails_("5124095h1h"));
+    TEST_CHECK(duration_fails_("18446744073709551616ns"));
+
+    TEST_CHECK(duration_fails_(""));
+    TEST_CHECK(duration_fails_("10"));
+    TEST_CHECK(duration_fails_("00"));
+    TEST_CHECK(duration_fails_("1h30"));
+    TEST_CHECK(duration_fails_("h"));
+    TEST_CHECK(duration_fails_("1d"));
+    TEST_CHECK(duration_fails_("1 h"));
+}
+
+int main(void)
+{
+    check_sizes_();
+    check_durations_();
+    return TEST_RESULT();
+}